@@ -17,6 +17,7 @@ class Grid;
 class NonzeroHeight;
 struct ChainMiningTask;
 struct Error;
+struct ThreadStats;
 namespace HeaderDownload {
 class Downloader;
 }
@@ -37,7 +38,10 @@ using BalanceCb = std::function<void(const tl::expected<API::Balance, int32_t>&)
 
 // using OffensesCb = std::function<void(const tl::expected<std, int32_t>&)>;
 using MempoolCb = std::function<void(const tl::expected<API::MempoolEntries, int32_t>&)>;
+using MempoolPageCb = std::function<void(const tl::expected<API::MempoolPage, int32_t>&)>;
+using FeeHistogramCb = std::function<void(const tl::expected<API::MempoolFeeHistogram, int32_t>&)>;
 using MempoolInsertCb = std::function<void(const tl::expected<TxHash, int32_t>&)>;
+using MempoolInsertBatchCb = std::function<void(const std::vector<tl::expected<TxHash, int32_t>>&)>;
 using MempoolTxsCb = std::function<void(std::vector<std::optional<TransferTxExchangeMessage>>&)>;
 using ChainMiningCb = std::function<void(const tl::expected<ChainMiningTask, Error>&)>;
 using MiningCb = std::function<void(const tl::expected<API::MiningState, Error>&)>;
@@ -59,5 +63,6 @@ using HistoryCb = std::function<void(const tl::expected<API::AccountHistory, int
 using RichlistCb = std::function<void(const tl::expected<API::Richlist, int32_t>&)>;
 
 using VersionCb = std::function<void(const tl::expected<PrintNodeVersion, int32_t>&)>;
+using ThreadStatsCb = std::function<void(const std::vector<ThreadStats>&)>;
 using WalletCb = std::function<void(const tl::expected<API::Wallet, int32_t>&)>;
 using RawCb = std::function<void(const API::Raw&)>;
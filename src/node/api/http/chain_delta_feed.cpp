@@ -0,0 +1,59 @@
+#include "chain_delta_feed.hpp"
+
+void ChainDeltaFeed::set_tip(Height length, const Hash& hash)
+{
+    if (tip)
+        return;
+    tip = base = Tip { length, hash };
+    if (length != 0)
+        recent.push_back(hash);
+}
+
+void ChainDeltaFeed::push_block(NonzeroHeight height, const Hash& hash, std::string json)
+{
+    if (!tip || tip->length + 1 != height)
+        recent.clear();
+    recent.push_back(hash);
+    if (recent.size() > maxEvents)
+        recent.pop_front();
+    push({ height, hash }, std::move(json));
+}
+
+void ChainDeltaFeed::push_rollback(Height length, std::string json)
+{
+    std::optional<Hash> hash;
+    const size_t drop { tip && length <= tip->length ? tip->length - length : recent.size() };
+    if (drop < recent.size()) {
+        recent.resize(recent.size() - drop);
+        hash = recent.back();
+    } else {
+        recent.clear();
+    }
+    push({ length, hash }, std::move(json));
+}
+
+void ChainDeltaFeed::push(Tip after, std::string json)
+{
+    bytes += json.size();
+    events.push_back({ after, std::move(json) });
+    endSeq += 1;
+    tip = after;
+    while (events.size() > 1 && (events.size() > maxEvents || bytes > maxBytes)) {
+        bytes -= events.front().json.size();
+        base = events.front().after;
+        events.pop_front();
+    }
+}
+
+auto ChainDeltaFeed::resume(Height length, const Hash& hash) const -> std::optional<uint64_t>
+{
+    // The latest point where our tip equaled the client's tip. The client's
+    // chain is our chain at that point, all later events apply to it.
+    for (size_t i = events.size();; --i) {
+        const std::optional<Tip> t { i == 0 ? base : events[i - 1].after };
+        if (t && t->length == length && (length == 0 || t->hash == hash))
+            return begin_seq() + i;
+        if (i == 0)
+            return {};
+    }
+}
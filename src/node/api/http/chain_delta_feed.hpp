@@ -0,0 +1,53 @@
+#pragma once
+#include "block/chain/height.hpp"
+#include "crypto/hash.hpp"
+#include <deque>
+#include <optional>
+#include <string>
+
+// Recently published /ws/chain_delta events, serialized once and shared by
+// all subscribers. Subscribers hold a cursor into this buffer instead of
+// having a copy of every event queued, so a slow consumer only costs the
+// bytes it has in flight. Also used to resume subscriptions from a block.
+class ChainDeltaFeed {
+public:
+    static constexpr size_t maxEvents { 1000 };
+    static constexpr size_t maxBytes { 32 * 1024 * 1024 };
+
+    // tip before the first event, lets clients at our tip resume after a
+    // restart, ignored once events were published
+    void set_tip(Height length, const Hash& hash);
+    void push_block(NonzeroHeight height, const Hash& hash, std::string json);
+    void push_rollback(Height length, std::string json);
+
+    // sequence numbers of buffered events are in [begin_seq(), end_seq())
+    uint64_t begin_seq() const { return endSeq - events.size(); }
+    uint64_t end_seq() const { return endSeq; }
+    const std::string& get(uint64_t seq) const
+    {
+        return events[seq - begin_seq()].json;
+    }
+
+    // Returns the sequence number to continue with for a client whose chain
+    // ends with block `hash` at height `length` (hash is ignored for length
+    // 0). Replaying from there includes the rollbacks to leave a fork the
+    // client is on. Returns nothing if the client's tip is not buffered.
+    std::optional<uint64_t> resume(Height length, const Hash& hash) const;
+
+private:
+    struct Tip {
+        Height length;
+        std::optional<Hash> hash; // unknown after rollbacks deeper than recent
+    };
+    struct Event {
+        Tip after;
+        std::string json;
+    };
+    void push(Tip after, std::string json);
+    std::deque<Event> events;
+    std::optional<Tip> base; // tip before the first buffered event
+    std::optional<Tip> tip; // tip after the last event
+    std::deque<Hash> recent; // hashes of the current chain up to tip
+    size_t bytes { 0 };
+    uint64_t endSeq { 0 };
+};
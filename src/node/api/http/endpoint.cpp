@@ -2,9 +2,11 @@
 #include "api/http/parse.hpp"
 #include "api/types/accountid_or_address.hpp"
 #include "api/types/all.hpp"
+#include "block/header/header_impl.hpp"
 #include "chainserver/transaction_ids.hpp"
 #include "communication/mining_task.hpp"
 #include "general/hex.hpp"
+#include "general/threads.hpp"
 #include "json.hpp"
 #include "spdlog/spdlog.h"
 #include "version.hpp"
@@ -48,6 +50,20 @@ struct ParameterParser {
     {
         return Funds::parse_throw(sv);
     }
+    operator mempool::PageOrder()
+    {
+        if (sv == "fee")
+            return mempool::PageOrder::Fee;
+        if (sv == "time")
+            return mempool::PageOrder::Time;
+        throw Error(EINV_ARGS);
+    }
+    operator std::optional<mempool::PageCursor>()
+    {
+        if (sv == "0")
+            return {};
+        return mempool::PageCursor::parse_throw(sv);
+    }
     operator Page()
     {
         return static_cast<uint32_t>(*this);
@@ -123,13 +139,17 @@ std::string IndexGenerator::result(bool isPublic) const
 
 void HTTPEndpoint::work()
 {
+    setup_thread(ThreadRole::RPC);
     app.get("/", [&](uWS::HttpResponse<false>* res, uWS::HttpRequest*) {
         send_html(res, indexGenerator.result(isPublic));
     });
 
     indexGenerator.section("Transaction Endpoints");
     post("/transaction/add", parse_payment_create, put_mempool);
+    post("/transaction/add_binary", parse_payment_create_binary, put_mempool_batch);
     get("/transaction/mempool", get_mempool);
+    get_2("/transaction/mempool/page/:order/:cursor", get_mempool_page);
+    get("/transaction/mempool/fee_histogram", get_mempool_fee_histogram);
     get_1("/transaction/lookup/:txid", lookup_tx);
     get("/transaction/latest", get_latest_transactions);
 
@@ -149,6 +169,7 @@ void HTTPEndpoint::work()
 
     indexGenerator.section("Account Endpoints");
     get_1("/account/:account/balance", get_account_balance);
+    get_2("/account/:account/balance/:height", get_account_balance_at);
     get_2("/account/:account/history/:beforeTxIndex", get_account_history);
     get("/account/richlist", get_account_richlist);
 
@@ -172,13 +193,43 @@ void HTTPEndpoint::work()
 
     indexGenerator.section("Debug Endpoints");
     get("/debug/header_download", inspect_eventloop, jsonmsg::header_download, true);
-    app.ws<int>("/ws/chain_delta", {
-                                       .open = [](auto* ws) {
-                                           ws->subscribe(API::Block::WEBSOCKET_EVENT);
-                                           ws->subscribe(API::Rollback::WEBSOCKET_EVENT);
-                                       },
-                                   });
-    app.listen(bind.ipv4.to_string(), bind.port, std::bind(&HTTPEndpoint::on_listen, this, _1));
+    get("/debug/threads", get_thread_stats, true);
+    app.ws<ChainDeltaSubscriber>("/ws/chain_delta",
+        {
+            // backpressure is bounded by chain_delta_flush
+            .maxBackpressure = 0,
+            .upgrade = [](auto* res, auto* req, auto* context) {
+                ChainDeltaSubscriber s;
+                if (auto from { req->getQuery("from") }; !from.empty()) {
+                    uint32_t h;
+                    auto r { std::from_chars(from.data(), from.end(), h) };
+                    if (r.ec != std::errc {} || r.ptr != from.end()) {
+                        res->writeStatus("400 Bad Request")->end();
+                        return;
+                    }
+                    s.known = Height(h > 0 ? h - 1 : 0);
+                    if (s.known->value() != 0 && !parse_hex(req->getQuery("hash"), s.knownHash)) {
+                        res->writeStatus("400 Bad Request")->end();
+                        return;
+                    }
+                }
+                res->template upgrade<ChainDeltaSubscriber>(std::move(s),
+                    req->getHeader("sec-websocket-key"),
+                    req->getHeader("sec-websocket-protocol"),
+                    req->getHeader("sec-websocket-extensions"),
+                    context);
+            },
+            .open = [this](auto* ws) { chain_delta_open(ws); },
+            .drain = [this](auto* ws) {
+                if (!chain_delta_flush(ws))
+                    ws->end(4000, "subscriber too slow");
+            },
+            .close = [this](auto* ws, int, std::string_view) { chainDeltaSubscribers.erase(ws); },
+        });
+    if (bind)
+        app.listen(bind->ipv4.to_string(), bind->port, std::bind(&HTTPEndpoint::on_listen, this, _1));
+    if (!unixSocket.path.empty())
+        app.listen_unix(std::bind(&HTTPEndpoint::on_listen_unix, this, _1), unixSocket.path);
     lc.loop->run();
 }
 
@@ -187,15 +238,19 @@ std::optional<HTTPEndpoint> HTTPEndpoint::make_public_endpoint(const Config&)
     auto& pAPI { config().publicAPI };
     if (!pAPI)
         return {};
-    return std::optional<HTTPEndpoint> { std::in_place, pAPI->bind, true };
+    return std::optional<HTTPEndpoint> { std::in_place, pAPI->bind, UnixSocketAddress {}, true };
 };
 
-HTTPEndpoint::HTTPEndpoint(EndpointAddress bind, bool isPublic)
+HTTPEndpoint::HTTPEndpoint(std::optional<EndpointAddress> bind, UnixSocketAddress unixSocket, bool isPublic)
     : bind(bind)
+    , unixSocket(std::move(unixSocket))
     , isPublic(isPublic)
     , app(lc.loop)
 {
-    spdlog::info("RPC {}endpoint is {}.", isPublic ? "public " : "", bind.to_string());
+    if (bind)
+        spdlog::info("RPC {}endpoint is {}.", isPublic ? "public " : "", bind->to_string());
+    if (!this->unixSocket.path.empty())
+        spdlog::info("RPC {}endpoint is {}.", isPublic ? "public " : "", this->unixSocket.to_string());
     t = std::thread(&HTTPEndpoint::work, this);
 }
 
@@ -337,6 +392,10 @@ void HTTPEndpoint::shutdown()
         us_listen_socket_close(0, listen_socket);
         listen_socket = nullptr;
     }
+    if (unix_listen_socket != nullptr) {
+        us_listen_socket_close(0, unix_listen_socket);
+        unix_listen_socket = nullptr;
+    }
 }
 
 void HTTPEndpoint::on_event(WebsocketEvent&& e)
@@ -347,23 +406,82 @@ void HTTPEndpoint::on_event(WebsocketEvent&& e)
         std::move(e));
 }
 
-void HTTPEndpoint::handle_event(const API::Block& b)
+namespace {
+std::string chain_delta_json(const API::Block& b)
 {
-    auto txt { nlohmann::json {
+    return nlohmann::json {
         { "type", "blockAppend" },
-        { "data", jsonmsg::to_json(b) } }
-                   .dump() };
-    app.publish(b.WEBSOCKET_EVENT, txt, uWS::OpCode::TEXT);
+        { "data", jsonmsg::to_json(b) }
+    }.dump();
+}
+std::string chain_delta_json(const API::Rollback& r)
+{
+    return nlohmann::json {
+        { "type", "rollback" },
+        { "data", jsonmsg::to_json(r) }
+    }.dump();
+}
+}
+
+void HTTPEndpoint::handle_event(const API::ChainHead& h)
+{
+    chainDeltaFeed.set_tip(h.height, h.hash);
+}
+
+void HTTPEndpoint::handle_event(const API::Block& b)
+{
+    chainDeltaFeed.push_block(b.height, b.header.hash(), chain_delta_json(b));
+    chain_delta_flush_all();
 }
 
 void HTTPEndpoint::handle_event(const API::Rollback& r)
 {
-    auto txt { nlohmann::json {
-        { "type", "rollback" },
-        { "data", jsonmsg::to_json(r) } }
-                   .dump() };
-    app.publish(r.WEBSOCKET_EVENT, txt, uWS::OpCode::TEXT);
+    chainDeltaFeed.push_rollback(r.length, chain_delta_json(r));
+    chain_delta_flush_all();
+}
+
+void HTTPEndpoint::chain_delta_open(ChainDeltaSocket* ws)
+{
+    auto& s { *ws->getUserData() };
+    s.next = chainDeltaFeed.end_seq();
+    if (s.known) {
+        auto seq { chainDeltaFeed.resume(*s.known, s.knownHash) };
+        if (!seq) {
+            ws->end(4001, "resume block not available");
+            return;
+        }
+        s.next = *seq;
+    }
+    chainDeltaSubscribers.insert(ws);
+    chain_delta_flush(ws);
 }
+
+bool HTTPEndpoint::chain_delta_flush(ChainDeltaSocket* ws)
+{
+    constexpr size_t maxBuffered { 256 * 1024 };
+    auto& s { *ws->getUserData() };
+    if (s.next < chainDeltaFeed.begin_seq())
+        return false; // fell behind the feed buffer
+    for (; s.next < chainDeltaFeed.end_seq(); ++s.next) {
+        if (ws->getBufferedAmount() > maxBuffered)
+            break; // continue on drain
+        ws->send(chainDeltaFeed.get(s.next), uWS::OpCode::TEXT);
+    }
+    return true;
+}
+
+void HTTPEndpoint::chain_delta_flush_all()
+{
+    std::vector<ChainDeltaSocket*> slow;
+    for (auto* ws : chainDeltaSubscribers) {
+        if (!chain_delta_flush(ws))
+            slow.push_back(ws);
+    }
+    // ending calls the close handler which erases from chainDeltaSubscribers
+    for (auto* ws : slow)
+        ws->end(4000, "subscriber too slow");
+}
+
 void HTTPEndpoint::send_reply(uWS::HttpResponse<false>* res, const std::string& s)
 {
     auto iter = pendingRequests.find(res);
@@ -386,5 +504,16 @@ void HTTPEndpoint::on_listen(us_listen_socket_t* ls)
             us_listen_socket_close(0, listen_socket);
         }
     } else
-        throw std::runtime_error("Cannot listen on " + bind.to_string());
+        throw std::runtime_error("Cannot listen on " + bind->to_string());
+}
+
+void HTTPEndpoint::on_listen_unix(us_listen_socket_t* ls)
+{
+    unix_listen_socket = ls;
+    if (!unix_listen_socket)
+        throw std::runtime_error("Cannot listen on " + unixSocket.to_string());
+    if (!unixSocket.apply_mode())
+        throw std::runtime_error("Cannot set mode of " + unixSocket.to_string());
+    if (bshutdown)
+        us_listen_socket_close(0, unix_listen_socket);
 }
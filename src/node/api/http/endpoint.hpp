@@ -1,5 +1,6 @@
 #pragma once
 #define UWS_NO_ZLIB
+#include "api/http/chain_delta_feed.hpp"
 #include "api/types/all.hpp"
 #include "block/block.hpp"
 #include "general/tcp_util.hpp"
@@ -7,9 +8,16 @@
 #include <thread>
 #include <variant>
 
-using WebsocketEvent = std::variant<API::Rollback,API::Block>;
+using WebsocketEvent = std::variant<API::ChainHead, API::Rollback, API::Block>;
 
 struct Config;
+struct ChainDeltaSubscriber {
+    std::optional<Height> known; // chain length the client resumes from
+    Hash knownHash; // hash of the client's last block
+    uint64_t next { 0 }; // sequence number of next event to send
+};
+using ChainDeltaSocket = uWS::WebSocket<false, true, ChainDeltaSubscriber>;
+
 class IndexGenerator {
 public:
     void get(std::string s);
@@ -25,7 +33,7 @@ private:
 class HTTPEndpoint {
 public:
     static std::optional<HTTPEndpoint> make_public_endpoint(const Config&);
-    HTTPEndpoint(EndpointAddress bind, bool isPublic = false);
+    HTTPEndpoint(std::optional<EndpointAddress> bind, UnixSocketAddress unixSocket = {}, bool isPublic = false);
     ~HTTPEndpoint()
     {
         lc.loop->defer(std::bind(&HTTPEndpoint::shutdown, this));
@@ -59,21 +67,30 @@ private:
     // handlers
     void on_aborted(uWS::HttpResponse<false>* res);
     void on_listen(us_listen_socket_t* ls);
+    void on_listen_unix(us_listen_socket_t* ls);
 
     //////////////////////////////
     // handlers for websocket events
+    void handle_event(const API::ChainHead&);
     void handle_event(const API::Block&);
     void handle_event(const API::Rollback&);
+    void chain_delta_open(ChainDeltaSocket*);
+    bool chain_delta_flush(ChainDeltaSocket*);
+    void chain_delta_flush_all();
 
     //////////////////////////////
     // variables
     IndexGenerator indexGenerator;
     std::set<uWS::HttpResponse<false>*> pendingRequests;
-    EndpointAddress bind;
+    std::optional<EndpointAddress> bind;
+    UnixSocketAddress unixSocket;
     bool isPublic;
     us_listen_socket_t* listen_socket = nullptr;
+    us_listen_socket_t* unix_listen_socket = nullptr;
     const uWS::LoopCleaner lc;
     uWS::App app;
     bool bshutdown = false;
+    ChainDeltaFeed chainDeltaFeed;
+    std::set<ChainDeltaSocket*> chainDeltaSubscribers;
     std::thread t;
 };
@@ -8,6 +8,7 @@
 #include "crypto/crypto.hpp"
 #include "eventloop/eventloop.hpp"
 #include "eventloop/sync/header_download/header_download.hpp"
+#include "general/threads.hpp"
 #include "eventloop/sync/sync.hpp"
 #include "general/errors.hpp"
 #include "general/hex.hpp"
@@ -34,7 +35,7 @@ struct Inspector {
     static auto endoints(const Eventloop& e)
     {
         auto& m = e.connections;
-        return std::tuple { &m.verified, &m.failedAddresses.data(), &m.unverifiedAddresses, &m.pendingOutgoing };
+        return std::tuple { &m.verified, &m.failedAddresses.data(), &m.unverifiedAddresses.data(), &m.pendingOutgoing };
     }
     static auto& ip_counter(const Conman& c)
     {
@@ -313,27 +314,72 @@ json to_json(const API::MiningState& ms)
     j["testnet"] = is_testnet();
     return j;
 }
+namespace {
+json mempool_entry_json(const API::MempoolEntry& e)
+{
+    json elem;
+    elem["fromAddress"] = e.from_address(e.txHash).to_string();
+    elem["pinHeight"] = e.pin_height();
+    elem["txHash"] = serialize_hex(e.txHash);
+    elem["nonceId"] = e.nonce_id();
+    elem["fee"] = e.fee().to_string();
+    elem["feeE8"] = e.fee().E8();
+    elem["toAddress"] = e.toAddr.to_string();
+    elem["amount"] = e.amount.to_string();
+    elem["amountE8"] = e.amount.E8();
+    return elem;
+}
+}
+
 json to_json(const API::MempoolEntries& entries)
 {
     json j;
     json a = json::array();
     for (auto& e : entries.entries) {
-        json elem;
-        elem["fromAddress"] = e.from_address(e.txHash).to_string();
-        elem["pinHeight"] = e.pin_height();
-        elem["txHash"] = serialize_hex(e.txHash);
-        elem["nonceId"] = e.nonce_id();
-        elem["fee"] = e.fee().to_string();
-        elem["feeE8"] = e.fee().E8();
-        elem["toAddress"] = e.toAddr.to_string();
-        elem["amount"] = e.amount.to_string();
-        elem["amountE8"] = e.amount.E8();
+        a.push_back(mempool_entry_json(e));
+    }
+    j["data"] = a;
+    return j;
+}
+
+json to_json(const API::MempoolPage& page)
+{
+    json a = json::array();
+    for (auto& e : page.entries) {
+        auto elem { mempool_entry_json(e) };
+        elem["timestamp"] = e.timestamp;
         a.push_back(elem);
     }
+    json j;
     j["data"] = a;
+    j["total"] = page.total;
+    if (page.next)
+        j["nextCursor"] = page.next->to_string();
+    else
+        j["nextCursor"] = nullptr;
     return j;
 }
 
+json to_json(const API::MempoolFeeHistogram& h)
+{
+    json buckets = json::array();
+    for (size_t i = 0; i < h.counts.size(); ++i) {
+        if (h.counts[i] == 0)
+            continue;
+        auto minFee { CompactUInt::from_value_assert(i << 10) };
+        buckets.push_back(json {
+            { "minFee", minFee.to_string() },
+            { "minFeeE8", minFee.uncompact().E8() },
+            { "count", h.counts[i] } });
+    }
+    return json {
+        { "total", h.total },
+        { "minFee", h.minFee.to_string() },
+        { "minFeeE8", h.minFee.uncompact().E8() },
+        { "buckets", buckets }
+    };
+}
+
 json to_json(const API::Transaction& tx)
 {
     return std::visit([&](const auto& e) {
@@ -491,6 +537,42 @@ std::string serialize(const std::vector<API::Peerinfo>& connected)
     return j.dump(1);
 }
 
+std::string serialize(const std::vector<tl::expected<TxHash, int32_t>>& results)
+{
+    json j = json::array();
+    for (auto& r : results) {
+        if (r.has_value()) {
+            j.push_back(json { { "code", 0 }, { "txHash", serialize_hex(*r) } });
+        } else {
+            j.push_back(json { { "code", r.error() }, { "error", Error(r.error()).strerror() } });
+        }
+    }
+    return json {
+        { "code", 0 },
+        { "data", j }
+    }.dump(1);
+}
+
+std::string serialize(const std::vector<ThreadStats>& stats)
+{
+    json j = json::array();
+    for (auto& s : stats) {
+        j.push_back(json {
+            { "role", s.role },
+            { "tid", s.tid },
+            { "cpuSeconds", s.cpuSeconds },
+            { "busyRatio", s.busyRatio },
+            { "voluntaryCtxSwitches", s.voluntaryCtxSwitches },
+            { "involuntaryCtxSwitches", s.involuntaryCtxSwitches },
+            { "cpus", s.cpus },
+            { "nice", s.nice } });
+    }
+    return json {
+        { "code", 0 },
+        { "data", j }
+    }.dump(1);
+}
+
 json to_json(const API::Balance& b)
 {
     json j;
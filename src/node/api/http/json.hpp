@@ -5,6 +5,7 @@ struct Head;
 class Hash;
 class TxHash;
 class Header;
+struct ThreadStats;
 namespace jsonmsg {
 
 nlohmann::json to_json(const API::Balance&);
@@ -17,6 +18,8 @@ nlohmann::json to_json(const EndpointAddress&);
 nlohmann::json to_json(const std::pair<NonzeroHeight,Header>&);
 nlohmann::json to_json(const API::MiningState&);
 nlohmann::json to_json(const API::MempoolEntries&);
+nlohmann::json to_json(const API::MempoolPage&);
+nlohmann::json to_json(const API::MempoolFeeHistogram&);
 nlohmann::json to_json(const API::Transaction&);
 nlohmann::json to_json(const API::PeerinfoConnections&);
 nlohmann::json to_json(const API::TransactionsByBlocks&);
@@ -129,6 +132,8 @@ inline std::string serialize(const std::vector<PeerDB::BanEntry>& banned)
 }
 
 std::string serialize(const std::vector<API::Peerinfo>& banned);
+std::string serialize(const std::vector<tl::expected<TxHash, int32_t>>&);
+std::string serialize(const std::vector<ThreadStats>&);
 
 std::string endpoints(const Eventloop&);
 std::string connect_timers(const Eventloop&);
@@ -133,6 +133,21 @@ PaymentCreateMessage parse_payment_create(const std::vector<uint8_t>& s)
     }
 }
 
+std::vector<PaymentCreateMessage> parse_payment_create_binary(const std::vector<uint8_t>& s)
+{
+    // concatenation of raw PaymentCreateMessage records
+    constexpr size_t maxRecords { 10000 };
+    constexpr size_t N { PaymentCreateMessage::bytesize };
+    if (s.size() == 0 || s.size() % N != 0 || s.size() / N > maxRecords)
+        throw Error(EINV_ARGS);
+    std::vector<PaymentCreateMessage> res;
+    res.reserve(s.size() / N);
+    Reader r(s);
+    while (r.remaining() > 0)
+        res.push_back(PaymentCreateMessage(r));
+    return res;
+}
+
 Funds parse_funds(const std::vector<uint8_t>& s)
 {
     std::string str(s.begin(), s.end());
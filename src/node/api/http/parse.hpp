@@ -3,4 +3,5 @@
 #include "communication/mining_task.hpp"
 ChainMiningTask parse_mining_task(const std::vector<uint8_t>& s);
 PaymentCreateMessage parse_payment_create(const std::vector<uint8_t>& s);
+std::vector<PaymentCreateMessage> parse_payment_create_binary(const std::vector<uint8_t>& s);
 Funds parse_funds(const std::vector<uint8_t>& s);
@@ -4,6 +4,7 @@
 #include "block/header/header_impl.hpp"
 #include "chainserver/server.hpp"
 #include "eventloop/eventloop.hpp"
+#include "general/threads.hpp"
 #include "global/globals.hpp"
 
 // mempool functions
@@ -12,9 +13,24 @@ void put_mempool(PaymentCreateMessage&& m, MempoolInsertCb cb)
     global().pcs->api_put_mempool(std::move(m), std::move(cb));
 }
 
+void put_mempool_batch(std::vector<PaymentCreateMessage>&& ms, MempoolInsertBatchCb cb)
+{
+    global().pcs->api_put_mempool_batch(std::move(ms), std::move(cb));
+}
+
 void get_mempool(MempoolCb cb)
 {
-    global().pcs->api_get_mempool(std::move(cb));
+    global().pel->api_get_mempool(std::move(cb));
+}
+
+void get_mempool_page(mempool::PageOrder order, std::optional<mempool::PageCursor> after, MempoolPageCb cb)
+{
+    global().pel->api_get_mempool_page(order, after, std::move(cb));
+}
+
+void get_mempool_fee_histogram(FeeHistogramCb cb)
+{
+    global().pel->api_get_fee_histogram(std::move(cb));
 }
 
 void lookup_tx(const Hash hash, TxCb f)
@@ -71,6 +87,11 @@ void get_version(VersionCb cb)
     cb(PrintNodeVersion {});
 }
 
+void get_thread_stats(ThreadStatsCb cb)
+{
+    cb(thread_stats());
+}
+
 void get_wallet_new(WalletCb cb)
 {
     cb(API::Wallet {});
@@ -283,6 +304,11 @@ void get_account_balance(const API::AccountIdOrAddress& address, BalanceCb f)
     global().pcs->api_get_balance(address, f);
 }
 
+void get_account_balance_at(const API::AccountIdOrAddress& address, Height height, BalanceCb f)
+{
+    global().pcs->api_get_balance_at(address, height, f);
+}
+
 void get_account_history(const Address& address, uint64_t beforeId,
     HistoryCb f)
 {
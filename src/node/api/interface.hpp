@@ -8,7 +8,10 @@
 
 // mempool cbunctions
 void put_mempool(PaymentCreateMessage&&, MempoolInsertCb);
+void put_mempool_batch(std::vector<PaymentCreateMessage>&&, MempoolInsertBatchCb);
 void get_mempool(MempoolCb cb);
+void get_mempool_page(mempool::PageOrder, std::optional<mempool::PageCursor> after, MempoolPageCb cb);
+void get_mempool_fee_histogram(FeeHistogramCb cb);
 void lookup_tx(const Hash hash, TxCb f);
 
 void get_latest_transactions(LatestTxsCb f);
@@ -35,6 +38,7 @@ void get_round16bit_e8(uint64_t e8, RoundCb cb);
 void get_round16bit_funds(Funds e8, RoundCb cb);
 void get_version(VersionCb cb);
 void get_wallet_new(WalletCb cb);
+void get_thread_stats(ThreadStatsCb cb);
 void get_wallet_from_privkey(const PrivKey& pk, WalletCb cb);
 void get_janushash_number(std::string_view, RawCb cb);
 
@@ -58,6 +62,7 @@ void get_headerdownload(HeaderdownloadCb f);
 
 // account functions
 void get_account_balance(const API::AccountIdOrAddress& address, BalanceCb cb);
+void get_account_balance_at(const API::AccountIdOrAddress& address, Height height, BalanceCb cb);
 void get_account_history(const Address& address, uint64_t end, HistoryCb cb);
 void get_account_richlist(RichlistCb cb);
 
@@ -3,8 +3,10 @@
 #include "api/interface.hpp"
 #include "block/header/header_impl.hpp"
 #include "general/tcp_util.hpp"
+#include "general/threads.hpp"
 #include "nlohmann/json.hpp"
 #include <cassert>
+#include <filesystem>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -201,7 +203,7 @@ namespace {
     }
 }
 
-Connection::Connection(std::shared_ptr<uvw::tcp_handle> newHandle, StratumServer& server)
+Connection::Connection(Handle newHandle, StratumServer& server)
     : extra2prefix(next_extra2prefix())
     , handle(std::move(newHandle))
     , server(server)
@@ -288,7 +290,7 @@ void send_work(std::string jobId, const Block& block);
 
 void Connection::shutdown()
 {
-    handle->shutdown();
+    std::visit([](auto& h) { h->shutdown(); }, handle);
 }
 
 void Connection::write_line(const std::string& line)
@@ -297,8 +299,11 @@ void Connection::write_line(const std::string& line)
     auto p { std::make_unique<char[]>(n) };
     memcpy(p.get(), line.data(), line.size());
     p.get()[n - 1] = '\n';
-    if (!handle->closing())
-        handle->write(std::move(p), n);
+    std::visit([&](auto& h) {
+        if (!h->closing())
+            h->write(std::move(p), n);
+    },
+        handle);
 }
 
 void Connection::process_line()
@@ -363,26 +368,25 @@ void StratumServer::handle_events()
     }
 }
 
-void StratumServer::acceptor(EndpointAddress endpointAddress)
+template <typename T>
+void StratumServer::accept_connections(T& listener)
 {
-    std::shared_ptr<uvw::tcp_handle> tcp = loop->resource<uvw::tcp_handle>();
-
-    tcp->on<uvw::error_event>([](const uvw::error_event&, uvw::tcp_handle&) { /* something went wrong */ });
-    tcp->on<uvw::listen_event>([this](const uvw::listen_event&, uvw::tcp_handle& srv) {
-        std::shared_ptr<uvw::tcp_handle> client = srv.parent().resource<uvw::tcp_handle>();
+    listener.template on<uvw::error_event>([](const uvw::error_event&, T&) { /* something went wrong */ });
+    listener.template on<uvw::listen_event>([this](const uvw::listen_event&, T& srv) {
+        std::shared_ptr<T> client = srv.parent().template resource<T>();
 
         assert(srv.accept(*client) == 0);
         assert(client->read() == 0);
         connections.emplace_front(std::make_shared<stratum::Connection>(client, *this));
         auto iter = connections.begin();
         auto& con { **iter };
-        client->on<uvw::close_event>([this, iter](const uvw::close_event&, uvw::tcp_handle&) {
+        client->template on<uvw::close_event>([this, iter](const uvw::close_event&, T&) {
             connections.erase(iter);
         });
-        client->on<uvw::end_event>([](const uvw::end_event&, uvw::tcp_handle& client) { client.close(); });
-        client->on<uvw::error_event>([](const uvw::error_event&, uvw::tcp_handle& client) { client.close(); });
-        client->on<uvw::shutdown_event>([](const uvw::shutdown_event&, uvw::tcp_handle& client) { client.close(); });
-        client->on<uvw::data_event>([&con](const uvw::data_event& de, uvw::tcp_handle& client) {
+        client->template on<uvw::end_event>([](const uvw::end_event&, T& client) { client.close(); });
+        client->template on<uvw::error_event>([](const uvw::error_event&, T& client) { client.close(); });
+        client->template on<uvw::shutdown_event>([](const uvw::shutdown_event&, T& client) { client.close(); });
+        client->template on<uvw::data_event>([&con](const uvw::data_event& de, T& client) {
             try {
                 con.on_message({ de.data.get(), de.length });
             } catch (const std::exception& e) {
@@ -394,27 +398,56 @@ void StratumServer::acceptor(EndpointAddress endpointAddress)
             }
         });
     });
-    auto check_result = [](int ec) {
-        if (ec != 0) {
-            throw std::runtime_error(uv_strerror(ec));
-        }
-    };
+}
 
-    ;
+namespace {
+void check_result(int ec)
+{
+    if (ec != 0) {
+        throw std::runtime_error(uv_strerror(ec));
+    }
+}
+}
+
+void StratumServer::acceptor(EndpointAddress endpointAddress)
+{
+    std::shared_ptr<uvw::tcp_handle> tcp = loop->resource<uvw::tcp_handle>();
+    accept_connections(*tcp);
     check_result(tcp->bind(endpointAddress.ipv4.to_string(), endpointAddress.port));
     check_result(tcp->listen());
 }
 
-StratumServer::StratumServer(EndpointAddress endpointAddress)
+void StratumServer::acceptor(const UnixSocketAddress& unixSocket)
+{
+    std::shared_ptr<uvw::pipe_handle> pipe = loop->resource<uvw::pipe_handle>();
+    accept_connections(*pipe);
+    std::error_code ec;
+    std::filesystem::remove(unixSocket.path, ec); // stale socket file of a previous run
+    check_result(pipe->bind(unixSocket.path));
+    check_result(pipe->listen());
+    if (!unixSocket.apply_mode())
+        throw std::runtime_error("Cannot set mode of " + unixSocket.to_string());
+}
+
+StratumServer::StratumServer(std::optional<EndpointAddress> endpointAddress, const UnixSocketAddress& unixSocket)
     : loop(uvw::loop::create())
     , async(loop->resource<uvw::async_handle>())
 {
-    spdlog::info("Starting Stratum server on {}", endpointAddress.to_string());
     async->on<uvw::async_event>([&](uvw::async_event&, uvw::async_handle&) {
         handle_events();
     });
-    acceptor(endpointAddress);
-    t = std::thread([&]() { loop->run(); });
+    if (endpointAddress) {
+        spdlog::info("Starting Stratum server on {}", endpointAddress->to_string());
+        acceptor(*endpointAddress);
+    }
+    if (!unixSocket.path.empty()) {
+        spdlog::info("Starting Stratum server on {}", unixSocket.to_string());
+        acceptor(unixSocket);
+    }
+    t = std::thread([&]() {
+        setup_thread(ThreadRole::Stratum);
+        loop->run();
+    });
 }
 
 StratumServer::~StratumServer()
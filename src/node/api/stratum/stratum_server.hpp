@@ -14,6 +14,7 @@ namespace uvw {
 class loop;
 class async_handle;
 class tcp_handle;
+class pipe_handle;
 };
 class StratumServer;
 namespace stratum {
@@ -37,7 +38,8 @@ class Connection : public std::enable_shared_from_this<Connection> {
     friend struct Writer;
 
 public:
-    Connection(std::shared_ptr<uvw::tcp_handle> newHandle, StratumServer& server);
+    using Handle = std::variant<std::shared_ptr<uvw::tcp_handle>, std::shared_ptr<uvw::pipe_handle>>;
+    Connection(Handle newHandle, StratumServer& server);
 
     void on_message(std::string_view msg);
     ~Connection();
@@ -61,7 +63,7 @@ private:
     const std::array<uint8_t,4> extra2prefix;
     std::optional<Authorized> authorized;
     std::string stratumLine;
-    std::shared_ptr<uvw::tcp_handle> handle;
+    Handle handle;
     StratumServer& server;
 };
 
@@ -104,12 +106,15 @@ class StratumServer {
     void handle_event(AppendResult&&);
 
     void acceptor(EndpointAddress endpointAddresss);
+    void acceptor(const UnixSocketAddress&);
+    template <typename T>
+    void accept_connections(T& listener);
     void link_authorized(const Address&, stratum::Connection*);
     void unlink_authorized(const Address&, stratum::Connection*);
 
     std::optional<Block> get_block(Address,std::string jobId);
 public:
-    StratumServer(EndpointAddress endpointAddress);
+    StratumServer(std::optional<EndpointAddress> endpointAddress, const UnixSocketAddress& unixSocket = {});
     ~StratumServer();
     void shutdown();
     void request_mining();
@@ -12,6 +12,7 @@
 #include "eventloop/peer_chain.hpp"
 #include "general/funds.hpp"
 #include "general/tcp_util.hpp"
+#include "mempool/page.hpp"
 #include "height_or_hash.hpp"
 #include "accountid_or_address.hpp"
 #include <variant>
@@ -120,10 +121,21 @@ struct Richlist {
 };
 struct MempoolEntry : public TransferTxExchangeMessage {
     Hash txHash;
+    uint32_t timestamp { 0 };
 };
 struct MempoolEntries {
     std::vector<MempoolEntry> entries;
 };
+struct MempoolPage {
+    std::vector<MempoolEntry> entries;
+    std::optional<mempool::PageCursor> next;
+    size_t total;
+};
+struct MempoolFeeHistogram {
+    mempool::FeeHistogram counts;
+    size_t total;
+    CompactUInt minFee;
+};
 struct OffenseHistory {
     std::vector<Hash> hashes;
     std::vector<TransferTxExchangeMessage> entries;
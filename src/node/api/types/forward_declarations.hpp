@@ -2,6 +2,8 @@
 #include <variant>
 namespace API {
 struct MempoolEntries;
+struct MempoolPage;
+struct MempoolFeeHistogram;
 struct TransferTransaction;
 struct Head;
 struct ChainHead;
@@ -81,9 +81,12 @@ void Conman::unref(const char* tag)
 
 void Conman::async_send(std::shared_ptr<Connection> c) // CALLED BY PROCESSING THREAD
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    events.push(Send { std::move(c) });
-    uv_async_send(&wakeup);
+    auto n { new SendNode { std::move(c), sendReady.load(std::memory_order_relaxed) } };
+    while (!sendReady.compare_exchange_weak(n->next, n,
+        std::memory_order_release, std::memory_order_relaxed))
+        ;
+    if (n->next == nullptr) // otherwise wakeup is already pending
+        uv_async_send(&wakeup);
 }
 
 void Conman::async_delete(std::shared_ptr<Connection> pcon) // POTENTIALLY CALLED BY OTHER THREAD
@@ -130,6 +133,8 @@ Conman::Conman(uv_loop_t* l, PeerServer& peerServer, const Config& config)
         goto error;
     wakeup.data = this;
     addref("wakeup");
+    if (!config.node.captureTraffic.empty())
+        capture.emplace(config.node.captureTraffic);
 
     return;
 error:
@@ -150,8 +155,36 @@ void Conman::on_connect(int status)
         return p->close(status);
     peerServer.async_validate(*this, p);
 }
+std::shared_ptr<Connection> Conman::replay_connect(const traffic_capture::ConnectData& d)
+{
+    auto [iter, inserted] = connections.emplace(std::make_shared<Connection>(*this, d.inbound));
+    const auto& p = *iter;
+    addref("connection");
+    p->start_replay(d);
+    return p;
+}
+void Conman::flush_send_ready()
+{
+    // reverse to preserve order of notification
+    SendNode* n { sendReady.exchange(nullptr, std::memory_order_acquire) };
+    SendNode* fifo { nullptr };
+    while (n) {
+        auto next { n->next };
+        n->next = fifo;
+        fifo = n;
+        n = next;
+    }
+    while (fifo) {
+        auto& c { *fifo->c };
+        c.sendScheduled.store(false, std::memory_order_release);
+        c.send_buffers();
+        delete std::exchange(fifo, fifo->next);
+    }
+}
+
 void Conman::on_wakeup()
 {
+    flush_send_ready();
     decltype(events) tmp;
     { // lock for very short time (swap)
         std::unique_lock<std::mutex> lock(mutex);
@@ -205,10 +238,6 @@ void Conman::handle_event(Close&& e)
 {
     e.c->close(e.reason);
 }
-void Conman::handle_event(Send&& e)
-{
-    e.c->send_buffers();
-}
 
 void Conman::handle_event(Validation&& e)
 {
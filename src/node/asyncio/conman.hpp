@@ -1,6 +1,8 @@
 #pragma once
 #include "helpers/per_ip_counter.hpp"
 #include "peerserver/peerserver.hpp"
+#include "traffic_capture.hpp"
+#include <atomic>
 #include <list>
 #include <set>
 
@@ -14,6 +16,7 @@ class Conman {
     friend class Connection;
     friend class Reconnecter;
     friend class PeerServer;
+    friend class TrafficReplay;
     struct ReconnectTimer;
     friend struct Inspector;
 
@@ -48,6 +51,9 @@ private:
     void async_close(std::shared_ptr<Connection> c, int32_t error); // POTENTIALLY CALLED BY OTHER THREAD
     void async_validate(std::weak_ptr<Connection> c, bool accept, int64_t rowid); // CALLED BY OTHER THREAD
 
+    // connection without socket fed by TrafficReplay
+    std::shared_ptr<Connection> replay_connect(const traffic_capture::ConnectData&);
+
 public:
     struct APIPeerdata {
         EndpointAddress address;
@@ -86,6 +92,7 @@ private:
     //--------------------------------------
     // data accessed by libuv thread
     PerIpCounter perIpCounter;
+    std::optional<traffic_capture::Recorder> capture;
     std::set<std::shared_ptr<Connection>> connections;
     std::list<ReconnectTimer> reconnectTimers;
     int refcount { 0 }; // count connections + tcp_handle + wakeup
@@ -101,9 +108,6 @@ private:
         std::shared_ptr<Connection> c;
         int32_t reason;
     };
-    struct Send {
-        std::shared_ptr<Connection> c;
-    };
     struct Validation {
         std::weak_ptr<Connection> c;
         bool accept;
@@ -119,7 +123,7 @@ private:
     struct Inspect {
         std::function<void(const Conman&)> callback;
     };
-    using Event = std::variant<Delete, Close, Send, Validation, GetPeers, Connect, Inspect>;
+    using Event = std::variant<Delete, Close, Validation, GetPeers, Connect, Inspect>;
     void async_add_event(Event e)
     {
         std::unique_lock<std::mutex> lock(mutex);
@@ -131,10 +135,19 @@ private:
     std::mutex mutex;
     std::queue<Event> events;
 
+    //--------------------------------------
+    // lock-free MPSC list of connections with pending writes, each
+    // connection is enqueued at most once until the uv thread drains it
+    struct SendNode {
+        std::shared_ptr<Connection> c;
+        SendNode* next;
+    };
+    std::atomic<SendNode*> sendReady { nullptr };
+    void flush_send_ready();
+
     // handle_event functions
     void handle_event(Delete&&);
     void handle_event(Close&&);
-    void handle_event(Send&&);
     void handle_event(Validation&&);
     void handle_event(GetPeers&&);
     void handle_event(Connect&&);
@@ -12,8 +12,10 @@ void Connection::write_cb(int status)
 {
     {
         std::unique_lock<std::mutex> lock(mutex);
-        bufferedbytes -= buffers.front().buf.len;
-        buffers.erase(buffers.begin());
+        for (size_t i { buffers.front().nbufs }; i > 0; --i) {
+            bufferedbytes -= buffers.front().buf.len;
+            buffers.erase(buffers.begin());
+        }
     }
     if (state != State::CONNECTED && state != State::HANDSHAKE)
         return;
@@ -43,6 +45,7 @@ void Connection::read_cb(ssize_t nread, const uv_buf_t* /*buf*/)
                     timeoutTimer.cancel();
                     handshakedata.reset(nullptr);
                     state = State::CONNECTED;
+                    capture_connect();
                     if (reconnectSleep) {
                         reconnectSleep = 0;
                     }
@@ -62,6 +65,7 @@ void Connection::read_cb(ssize_t nread, const uv_buf_t* /*buf*/)
                     if (inbound) {
                         peerEndpointPort = hb.port(inbound);
                     }
+                    negotiate_capabilities();
                     send_handshake();
                     hb.waitForAck = true;
                 }
@@ -78,11 +82,13 @@ void Connection::read_cb(ssize_t nread, const uv_buf_t* /*buf*/)
                     return;
                 }
                 spdlog::debug("Handshake valid, peer version {}", peerVersion.to_string());
+                negotiate_capabilities();
                 if (handshakedata->handshakesent == false)
                     send_handshake();
                 timeoutTimer.cancel();
                 handshakedata.reset(nullptr);
                 state = State::CONNECTED;
+                capture_connect();
                 if (reconnectSleep) {
                     reconnectSleep = 0;
                 }
@@ -103,18 +109,80 @@ void Connection::read_cb(ssize_t nread, const uv_buf_t* /*buf*/)
     if (stagebuffer.body.bytes.size() != 0 && stagebuffer.pos == 8 + stagebuffer.body.bytes.size()) {
         if (stagebuffer.finished()) {
             spdlog::debug("Received complete message");
-
-            {
-                std::unique_lock<std::mutex> lock(mutex);
-                readbuffers.push_back(std::move(stagebuffer));
-                stagebuffer.pos = 0;
-            }
-            eventloop_notify();
+            if (conman.capture)
+                conman.capture->message(id, std::span(stagebuffer.header, 8), stagebuffer.body.bytes);
+            process_message();
         } else {
             stagebuffer.realloc();
         }
     }
 }
+
+void Connection::process_message()
+{
+    // verify and decode here such that the eventloop thread only
+    // dispatches typed messages
+    if (!stagebuffer.verify(checksumType)) {
+        close(ECHECKSUM);
+        return;
+    }
+    std::optional<messages::Msg> m;
+    try {
+        m = stagebuffer.parse();
+    } catch (Error e) {
+        close(e.e);
+        return;
+    }
+    stagebuffer.pos = 0;
+    stagebuffer.body.bytes = {}; // do not keep large buffers per connection
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        readbuffers.push_back(std::move(*m));
+    }
+    eventloop_notify();
+}
+
+void Connection::capture_connect()
+{
+    if (conman.capture)
+        conman.capture->connect(id, { inbound, peerAddress, peerVersion, checksumType });
+}
+
+void Connection::start_replay(const traffic_capture::ConnectData& d)
+{
+    peerAddress = d.peer;
+    peerEndpointPort = d.peer.port;
+    peerVersion = d.version;
+    checksumType = d.checksumType;
+    handshakedata.reset(nullptr);
+    conman.count_force(peerAddress.ipv4);
+    state = State::CONNECTED;
+    connection_log().info("{} replaying", to_string());
+    eventloop_notify();
+}
+
+void Connection::replay_message(std::vector<uint8_t>&& bytes)
+{
+    if (state != State::CONNECTED)
+        return;
+    if (bytes.size() < 10) {
+        close(EMSGLEN);
+        return;
+    }
+    memcpy(stagebuffer.header, bytes.data(), 10);
+    if (int r = stagebuffer.allocate_body()) {
+        close(r);
+        return;
+    }
+    if (bytes.size() != 8 + stagebuffer.bsize) {
+        close(EMSGLEN);
+        return;
+    }
+    bytes.erase(bytes.begin(), bytes.begin() + 8);
+    stagebuffer.body.bytes = std::move(bytes);
+    stagebuffer.pos = 8 + stagebuffer.bsize;
+    process_message();
+}
 void Connection::alloc_cb(size_t /*suggested_size*/, uv_buf_t* buf)
 {
     if (handshakedata) {
@@ -188,7 +256,8 @@ void Connection::send_handshake()
     }
     uint32_t nver{hton32(NodeVersion::our_version().to_uint32())};
     memcpy(data + 14, &nver, 4);
-    memset(data + 18, 0, 4);
+    uint32_t ncap { hton32(Handshakedata::our_capabilities) };
+    memcpy(data + 18, &ncap, 4);
     if (!inbound) {
         uint16_t portBe = hton16(conman.bindAddress.port);
         memcpy(data + 22, &portBe, 2);
@@ -198,6 +267,14 @@ void Connection::send_handshake()
     }
     handshakedata->handshakesent = true;
 }
+void Connection::negotiate_capabilities()
+{
+    // legacy peers send zeros in the capability bytes
+    const uint32_t common { Handshakedata::our_capabilities & handshakedata->capabilities() };
+    if (common & Handshakedata::capability_crc32c)
+        checksumType = ChecksumType::CRC32C;
+}
+
 void Connection::send_handshake_ack()
 {
     char* data = new char[1];
@@ -208,17 +285,29 @@ void Connection::send_handshake_ack()
 int Connection::send_buffers()
 {
     std::unique_lock<std::mutex> lock(mutex);
-    assert(tcp);
-    while (buffercursor != buffers.end()) {
-        buffercursor->write_t.data = this;
-        if (int r = uv_write(&buffercursor->write_t, tcp->to_stream_ptr(),
-                &buffercursor->buf, 1, [](uv_write_t* req, int status) {
-                    Connection& con = (*reinterpret_cast<Connection*>(req->data));
-                    con.write_cb(status);
-                }))
-            return r;
-        ++buffercursor;
+    if (!tcp) { // replayed connection, discard outbound data
+        buffers.clear();
+        bufferedbytes = 0;
+        buffercursor = buffers.end();
+        return 0;
     }
+    if (buffercursor == buffers.end())
+        return 0;
+
+    // flush all pending buffers with a single write request
+    std::vector<uv_buf_t> bufs;
+    auto first { buffercursor };
+    for (auto it { first }; it != buffers.end(); ++it)
+        bufs.push_back(it->buf);
+    first->nbufs = bufs.size();
+    first->write_t.data = this;
+    if (int r = uv_write(&first->write_t, tcp->to_stream_ptr(),
+            bufs.data(), bufs.size(), [](uv_write_t* req, int status) {
+                Connection& con = (*reinterpret_cast<Connection*>(req->data));
+                con.write_cb(status);
+            }))
+        return r;
+    buffercursor = buffers.end();
     return 0;
 }
 
@@ -321,6 +410,8 @@ void Connection::close(int errcode)
         global().pel->async_report_failed_outbound(peerAddress);
     }
 
+    if (state == State::CONNECTED && conman.capture)
+        conman.capture->close(id, errcode);
     state = State::CLOSING;
     connection_log().info("{} closed: {} ({})",
         to_string(), errors::err_name(errcode), errors::strerror(errcode));
@@ -348,10 +439,10 @@ void Connection::close(int errcode)
 //////////////////////////////
 
 // CALLED BY OTHER THREAD
-std::vector<Rcvbuffer> Connection::extractMessages()
+std::vector<messages::Msg> Connection::extractMessages()
 {
     std::unique_lock<std::mutex> lock(mutex);
-    std::vector<Rcvbuffer> tmp;
+    std::vector<messages::Msg> tmp;
     tmp.swap(readbuffers);
     return tmp;
 }
@@ -362,7 +453,7 @@ std::string Connection::to_string() const
 }
 
 // CALLED BY OTHER THREAD
-void Connection::async_send(std::unique_ptr<char[]> data, size_t size)
+void Connection::async_send(std::shared_ptr<const char[]> data, size_t size)
 {
     std::unique_lock<std::mutex> lock(mutex);
     if (state == State::CLOSING)
@@ -374,15 +465,22 @@ void Connection::async_send(std::unique_ptr<char[]> data, size_t size)
     if (bufferedbytes >= MAXBUFFER) {
         async_close(EBUFFERFULL);
     }
-    conman.async_send(shared_from_this());
+    lock.unlock();
+    if (!sendScheduled.exchange(true, std::memory_order_acq_rel))
+        conman.async_send(shared_from_this());
 }
 
 void Connection::asyncsend(Sndbuffer&& msg)
 {
-    msg.writeChecksum();
+    msg.writeChecksum(checksumType);
     async_send(std::move(msg.ptr), msg.fullsize());
 }
 
+void Connection::asyncsend(const SharedSndbuffer& msg)
+{
+    async_send(msg.data(checksumType), msg.fullsize());
+}
+
 void Connection::async_close(int32_t errcode) { conman.async_close(shared_from_this(), errcode); }
 
 void Connection::eventloop_notify()
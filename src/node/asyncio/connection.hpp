@@ -3,6 +3,7 @@
 #include "communication/buffers/recvbuffer.hpp"
 #include "communication/buffers/sndbuffer.hpp"
 #include "conman.hpp"
+#include "traffic_capture.hpp"
 #include "eventloop/types/conref_declaration.hpp"
 
 class Connection final : public std::enable_shared_from_this<Connection> {
@@ -86,15 +87,18 @@ private:
     // Connection counts its references and will eventually be destructed by
     // Conman using delete It must be created with new
     friend class Conman;
+    friend class TrafficReplay;
     struct Writebuffer {
         uv_write_t write_t;
         uv_buf_t buf;
-        Writebuffer(std::unique_ptr<char[]>&& data, size_t size)
+        std::shared_ptr<const char[]> data; // might be shared with other connections
+        size_t nbufs { 0 }; // number of buffers written together with this one as first
+        Writebuffer(std::shared_ptr<const char[]> d, size_t size)
+            : data(std::move(d))
         {
             buf.len = size;
-            buf.base = data.release();
+            buf.base = const_cast<char*>(data.get()); // libuv does not write to it
         }
-        ~Writebuffer() { delete[] buf.base; }
     };
     struct Handshakedata {
         std::array<uint8_t, 25> recvbuf; // 14 bytes for "WARTHOG GRUNT!" and 4
@@ -111,6 +115,16 @@ private:
         uint8_t pos = 0;
         bool handshakesent = false;
         NodeVersion version(bool inbound);
+
+        // capability bits transmitted in the 4 extra bytes
+        static constexpr uint32_t capability_crc32c = 1 << 0;
+        static constexpr uint32_t our_capabilities = capability_crc32c;
+        uint32_t capabilities()
+        {
+            uint32_t tmp;
+            memcpy(&tmp, recvbuf.data() + 18, 4);
+            return ntoh32(tmp);
+        }
         uint16_t port(bool inbound)
         {
             assert(inbound);
@@ -138,7 +152,7 @@ private:
 
     //////////////////////////////
     // mutex protected methods
-    void async_send(std::unique_ptr<char[]> data, size_t size);
+    void async_send(std::shared_ptr<const char[]> data, size_t size);
 
 public:
     enum class State { CONNECTING,
@@ -146,8 +160,9 @@ public:
         CONNECTED,
         CLOSING,
     };
-    std::vector<Rcvbuffer> extractMessages();
+    std::vector<messages::Msg> extractMessages();
     void asyncsend(Sndbuffer&& msg);
+    void asyncsend(const SharedSndbuffer& msg);
     void async_close(int errcode);
     [[nodiscard]] EndpointAddress peer_address() { return peerAddress; }
     [[nodiscard]] NodeVersion peer_version() const { return peerVersion; }
@@ -163,6 +178,9 @@ private:
     void close(int errcode);
     void send_handshake();
     void send_handshake_ack();
+    void negotiate_capabilities();
+    void process_message();
+    void capture_connect();
     int send_buffers();
 
     //////////////////////////////
@@ -172,6 +190,11 @@ private:
     int start_read();
     void eventloop_notify();
 
+    //////////////////////////////
+    // Traffic replay without socket
+    void start_replay(const traffic_capture::ConnectData&);
+    void replay_message(std::vector<uint8_t>&& bytes);
+
 public:
     // data accessed by eventloop thread
     bool eventloop_registered = false;
@@ -195,6 +218,7 @@ private:
     Rcvbuffer stagebuffer;
     std::unique_ptr<Handshakedata> handshakedata;
     NodeVersion peerVersion;
+    ChecksumType checksumType { ChecksumType::SHA256 }; // fixed after handshake
     int64_t logrow = -1;
     State state = State::CONNECTING;
     EndpointAddress peerAddress;
@@ -202,6 +226,9 @@ private:
     std::shared_ptr<TCP_t> tcp;
     TimeoutTimer timeoutTimer;
 
+    // set while connection is enqueued in Conman's send ready list
+    std::atomic<bool> sendScheduled { false };
+
     //////////////////////////////
     // Mutex locked members
     std::mutex mutex;
@@ -209,5 +236,5 @@ private:
     std::set<EndpointAddress> reconnect;
     uint32_t bufferedbytes = 0;
     std::list<Writebuffer>::iterator buffercursor;
-    std::vector<Rcvbuffer> readbuffers;
+    std::vector<messages::Msg> readbuffers; // verified and decoded
 };
@@ -0,0 +1,152 @@
+#include "traffic_capture.hpp"
+#include "general/reader.hpp"
+#include "general/writer.hpp"
+#include "spdlog/spdlog.h"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace traffic_capture {
+namespace {
+constexpr std::array<uint8_t, 8> magic { 'W', 'A', 'R', 'T', 'C', 'A', 'P', '1' };
+constexpr size_t connectSize { 1 + 4 + 2 + 4 + 1 };
+constexpr size_t maxMessageSize { 100 * 1024 * 1024 };
+}
+
+Recorder::Recorder(const std::string& path)
+    : path(path)
+    , file(fopen(path.c_str(), "wb"))
+    , start(std::chrono::steady_clock::now())
+{
+    if (!file)
+        throw std::runtime_error("Cannot open traffic capture \"" + path + "\": " + strerror(errno));
+    setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    write(magic);
+    spdlog::warn("Capturing inbound P2P traffic to \"{}\"", path);
+}
+
+Recorder::~Recorder()
+{
+    fclose(file);
+}
+
+void Recorder::write(std::span<const uint8_t> s)
+{
+    if (failed)
+        return;
+    if (fwrite(s.data(), 1, s.size(), file) != s.size()) {
+        failed = true;
+        spdlog::error("Cannot write traffic capture \"{}\", capture stopped: {}", path, strerror(errno));
+    }
+}
+
+void Recorder::write(Type type, uint64_t conId, std::span<const uint8_t> payload)
+{
+    const uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start)
+                                .count();
+    std::array<uint8_t, headerSize> h;
+    ::Writer(h.data(), h.size()) << uint8_t(type) << conId << micros;
+    write(h);
+    write(payload);
+}
+
+void Recorder::connect(uint64_t conId, const ConnectData& d)
+{
+    std::array<uint8_t, connectSize> a;
+    ::Writer(a.data(), a.size()) << uint8_t(d.inbound) << d.peer.ipv4.data
+                                 << d.peer.port << d.version.to_uint32()
+                                 << uint8_t(d.checksumType);
+    write(Connect, conId, a);
+}
+
+void Recorder::message(uint64_t conId, std::span<const uint8_t> head, std::span<const uint8_t> body)
+{
+    std::array<uint8_t, 4> size;
+    ::Writer(size.data(), size.size()) << uint32_t(head.size() + body.size());
+    write(Message, conId, size);
+    write(head);
+    write(body);
+}
+
+void Recorder::close(uint64_t conId, int32_t error)
+{
+    std::array<uint8_t, 4> a;
+    ::Writer(a.data(), a.size()) << uint32_t(error);
+    write(Close, conId, a);
+}
+
+RecordReader::RecordReader(const std::string& path)
+    : file(fopen(path.c_str(), "rb"))
+{
+    if (!file)
+        throw std::runtime_error("Cannot open traffic capture \"" + path + "\": " + strerror(errno));
+    std::array<uint8_t, 8> m;
+    if (!read(m.data(), m.size()) || m != magic) {
+        fclose(file);
+        throw std::runtime_error("\"" + path + "\" is not a traffic capture");
+    }
+}
+
+RecordReader::~RecordReader()
+{
+    fclose(file);
+}
+
+bool RecordReader::read(uint8_t* p, size_t n)
+{
+    return fread(p, 1, n, file) == n;
+}
+
+std::optional<Record> RecordReader::next()
+{
+    std::array<uint8_t, headerSize> h;
+    if (!read(h.data(), h.size()))
+        return {};
+    ::Reader r(h);
+    auto type { r.uint8() };
+    Record rec { .conId = r.uint64(), .micros = r.uint64(), .data {} };
+    switch (type) {
+    case Connect: {
+        std::array<uint8_t, connectSize> a;
+        if (!read(a.data(), a.size()))
+            return {};
+        ::Reader r(a);
+        bool inbound { r.uint8() != 0 };
+        IPv4 ip { r.uint32() };
+        uint16_t port { r.uint16() };
+        auto version { NodeVersion::from_uint32_t(r.uint32()) };
+        rec.data = ConnectData {
+            .inbound = inbound,
+            .peer { ip, port },
+            .version = version,
+            .checksumType = ChecksumType(r.uint8())
+        };
+        return rec;
+    }
+    case Message: {
+        std::array<uint8_t, 4> a;
+        if (!read(a.data(), a.size()))
+            return {};
+        size_t size { ::Reader(a).uint32() };
+        if (size > maxMessageSize)
+            return {};
+        MessageData d;
+        d.bytes.resize(size);
+        if (!read(d.bytes.data(), size))
+            return {};
+        rec.data = std::move(d);
+        return rec;
+    }
+    case Close: {
+        std::array<uint8_t, 4> a;
+        if (!read(a.data(), a.size()))
+            return {};
+        rec.data = CloseData { int32_t(::Reader(a).uint32()) };
+        return rec;
+    }
+    default:
+        return {};
+    }
+}
+}
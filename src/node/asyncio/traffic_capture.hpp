@@ -0,0 +1,83 @@
+#pragma once
+#include "communication/buffers/checksum.hpp"
+#include "general/tcp_util.hpp"
+#include "version.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Capture of inbound P2P traffic for offline profiling with wart-replay.
+// The file starts with the 8 bytes "WARTCAP1" followed by records
+//
+//   uint8  type
+//   uint64 connection id
+//   uint64 microseconds since capture start
+//   payload:
+//     Connect: uint8 inbound, uint32 ipv4, uint16 port, uint32 peer version,
+//              uint8 checksum type
+//     Message: uint32 size, message as received (body size, checksum, type, body)
+//     Close:   int32 error
+//
+// All integers are in network byte order. A truncated last record is
+// ignored by the reader.
+namespace traffic_capture {
+enum Type : uint8_t {
+    Connect = 1,
+    Message = 2,
+    Close = 3
+};
+struct ConnectData {
+    bool inbound;
+    EndpointAddress peer;
+    NodeVersion version;
+    ChecksumType checksumType;
+};
+struct MessageData {
+    std::vector<uint8_t> bytes;
+};
+struct CloseData {
+    int32_t error;
+};
+struct Record {
+    uint64_t conId;
+    uint64_t micros;
+    std::variant<ConnectData, MessageData, CloseData> data;
+};
+constexpr size_t headerSize { 1 + 8 + 8 };
+
+// used by the libuv thread only
+class Recorder {
+public:
+    Recorder(const std::string& path);
+    Recorder(const Recorder&) = delete;
+    ~Recorder();
+    void connect(uint64_t conId, const ConnectData&);
+    void message(uint64_t conId, std::span<const uint8_t> head, std::span<const uint8_t> body);
+    void close(uint64_t conId, int32_t error);
+
+private:
+    void write(Type, uint64_t conId, std::span<const uint8_t> payload);
+    void write(std::span<const uint8_t>);
+    std::string path;
+    FILE* file;
+    std::chrono::steady_clock::time_point start;
+    bool failed { false };
+};
+
+class RecordReader {
+public:
+    RecordReader(const std::string& path);
+    RecordReader(const RecordReader&) = delete;
+    ~RecordReader();
+    std::optional<Record> next();
+
+private:
+    bool read(uint8_t* p, size_t n);
+    FILE* file;
+};
+}
@@ -0,0 +1,99 @@
+#include "traffic_replay.hpp"
+#include "conman.hpp"
+#include "connection.hpp"
+#include "spdlog/spdlog.h"
+
+namespace {
+constexpr size_t maxBacklog { 256 }; // messages not yet picked up by the eventloop
+}
+
+TrafficReplay::TrafficReplay(Conman& conman, const std::string& path, double speed)
+    : conman(conman)
+    , reader(path)
+    , speed(speed)
+    , pending(reader.next())
+    , start(std::chrono::steady_clock::now())
+{
+    spdlog::info("Replaying traffic capture \"{}\" at {}", path,
+        speed > 0 ? std::to_string(speed) + "x speed" : "maximal speed");
+    uv_timer_init(conman.loop(), &timer);
+    timer.data = this;
+    rearm(0);
+}
+
+void TrafficReplay::timer_caller(uv_timer_t* handle)
+{
+    static_cast<TrafficReplay*>(handle->data)->on_timer();
+}
+
+size_t TrafficReplay::backlog()
+{
+    size_t n { 0 };
+    for (auto& [_, c] : connections) {
+        std::unique_lock<std::mutex> lock(c->mutex);
+        if (c->state == Connection::State::CONNECTED)
+            n += c->readbuffers.size();
+    }
+    return n;
+}
+
+void TrafficReplay::rearm(uint64_t milliseconds)
+{
+    uv_timer_start(&timer, timer_caller, milliseconds, 0);
+}
+
+void TrafficReplay::on_timer()
+{
+    if (conman.closing)
+        return finish(false);
+    using namespace std::chrono;
+    const auto elapsed { duration_cast<microseconds>(steady_clock::now() - start).count() };
+    while (pending) {
+        if (speed > 0) {
+            const auto due { int64_t(pending->micros / speed) };
+            if (due > elapsed)
+                return rearm((due - elapsed + 999) / 1000);
+        } else if (backlog() >= maxBacklog) {
+            return rearm(1);
+        }
+        apply(std::move(*pending));
+        pending = reader.next();
+    }
+    if (backlog() > 0)
+        return rearm(1);
+    finish(true);
+}
+
+void TrafficReplay::apply(traffic_capture::Record&& r)
+{
+    using namespace traffic_capture;
+    std::visit([&]<typename T>(T& d) {
+        if constexpr (std::is_same_v<T, ConnectData>) {
+            connections.insert_or_assign(r.conId, conman.replay_connect(d));
+        } else {
+            auto iter { connections.find(r.conId) };
+            if (iter == connections.end())
+                return;
+            if constexpr (std::is_same_v<T, MessageData>) {
+                messages += 1;
+                bytes += d.bytes.size();
+                iter->second->replay_message(std::move(d.bytes));
+            } else {
+                iter->second->close(d.error);
+                connections.erase(iter);
+            }
+        }
+    },
+        r.data);
+}
+
+void TrafficReplay::finish(bool closeConman)
+{
+    using namespace std::chrono;
+    const auto seconds { duration<double>(steady_clock::now() - start).count() };
+    spdlog::info("Replayed {} messages ({} bytes) in {:.3f} seconds", messages, bytes, seconds);
+    connections.clear();
+    uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+    if (closeConman)
+        conman.close(EREPLAYEND);
+}
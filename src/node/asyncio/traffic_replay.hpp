@@ -0,0 +1,37 @@
+#pragma once
+#include "traffic_capture.hpp"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <uv.h>
+
+class Conman;
+class Connection;
+
+// Feeds a traffic capture into the connection manager on its libuv loop.
+// Records are replayed at their captured time divided by speed. Speed 0
+// replays as fast as the eventloop picks up the messages. Outbound data is
+// discarded. The connection manager is closed after the last record.
+class TrafficReplay {
+public:
+    TrafficReplay(Conman&, const std::string& path, double speed);
+    TrafficReplay(const TrafficReplay&) = delete;
+
+private:
+    static void timer_caller(uv_timer_t* handle);
+    void on_timer();
+    void rearm(uint64_t milliseconds);
+    void apply(traffic_capture::Record&&);
+    size_t backlog();
+    void finish(bool closeConman);
+
+    Conman& conman;
+    traffic_capture::RecordReader reader;
+    const double speed;
+    uv_timer_t timer;
+    std::optional<traffic_capture::Record> pending;
+    std::chrono::steady_clock::time_point start;
+    std::map<uint64_t, std::shared_ptr<Connection>> connections; // by captured id
+    size_t messages { 0 };
+    size_t bytes { 0 };
+};
@@ -1,7 +1,9 @@
 #pragma once
 #include "block/chain/pin.hpp"
 #include "general/errors.hpp"
+#include <algorithm>
 #include <span>
+#include <utility>
 
 class Worksum;
 class Headerchain;
@@ -28,11 +30,34 @@ public:
         assert(begin <= end);
         assert(((end - begin) % 80) == 0);
     }
+    // copies never reference mapped memory
+    Headervec(const Headervec& other)
+        : bytes(other.raw().begin(), other.raw().end())
+    {
+    }
+    Headervec(Headervec&& other) noexcept
+        : bytes(std::move(other.bytes))
+        , mapped(std::exchange(other.mapped, {}))
+    {
+    }
+    Headervec& operator=(const Headervec& other)
+    {
+        if (this != &other)
+            assign(other.data(), other.data() + other.raw().size());
+        return *this;
+    }
+    Headervec& operator=(Headervec&& other) noexcept
+    {
+        bytes = std::move(other.bytes);
+        mapped = std::exchange(other.mapped, {});
+        return *this;
+    }
     void assign(const uint8_t* begin, const uint8_t* end)
     {
         assert(begin <= end);
         assert(((end - begin) % 80) == 0);
         bytes.assign(begin, end);
+        mapped = {};
     }
     class const_iterator {
     public:
@@ -66,56 +91,90 @@ public:
     {
         assign(begin.pos, end.pos);
     }
-    const_iterator begin() const { return bytes.data(); }
-    const_iterator end() const { return bytes.data() + bytes.size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + raw().size(); }
 
     void shrink(size_t elements)
     {
         size_t newsize = elements * 80;
-        assert(newsize <= bytes.size());
+        assert(newsize <= raw().size());
+        own();
         bytes.resize(newsize);
     }
-    const std::vector<uint8_t>& raw() const { return bytes; }
-    const uint8_t* data() const { return bytes.data(); }
-    size_t size() const { return bytes.size() / 80; }
+    std::span<const uint8_t> raw() const
+    {
+        if (is_mapped())
+            return mapped;
+        return bytes;
+    }
+    const uint8_t* data() const { return raw().data(); }
+    size_t size() const { return raw().size() / 80; }
     inline HeaderView operator[](size_t i) const
     {
-        auto pos = bytes.data() + i * 80;
-        assert(bytes.size() >= (i + 1) * 80);
+        auto pos = data() + i * 80;
+        assert(raw().size() >= (i + 1) * 80);
         return HeaderView(pos);
     }
     inline HeaderView last() const
     {
-        assert(bytes.size() >= 80);
-        return HeaderView(bytes.data() + size() * 80 - 1 * 80);
+        assert(raw().size() >= 80);
+        return HeaderView(data() + size() * 80 - 1 * 80);
     }
-    inline HeaderView first() const { return HeaderView(bytes.data()); }
-    bool operator==(const Headervec& b) const { return bytes == b.bytes; }
+    inline HeaderView first() const { return HeaderView(data()); }
+    bool operator==(const Headervec& b) const { return std::ranges::equal(raw(), b.raw()); }
     std::optional<HeaderView> get_header(size_t id) const
     {
         size_t offset = id * 80;
-        if (bytes.size() < offset + 80)
+        if (raw().size() < offset + 80)
             return {};
-        return HeaderView { bytes.data() + offset };
+        return HeaderView { data() + offset };
     }
-    void swap(Headervec& b) { bytes.swap(b.bytes); };
+    void swap(Headervec& b)
+    {
+        bytes.swap(b.bytes);
+        std::swap(mapped, b.mapped);
+    };
     HeaderView back() const
     {
-        return HeaderView(bytes.data() + bytes.size() - 80);
+        return HeaderView(data() + raw().size() - 80);
     }
     void append(HeaderView hv)
     {
+        own();
         bytes.insert(bytes.end(), hv.data(), hv.data() + 80);
     }
     void append(const Headervec& b)
     {
-        bytes.insert(bytes.end(), b.bytes.begin(), b.bytes.end());
+        own();
+        bytes.insert(bytes.end(), b.raw().begin(), b.raw().end());
+    }
+    void clear()
+    {
+        bytes.clear();
+        mapped = {};
     }
-    void clear() { bytes.clear(); }
+
+    // Headers are read from memory owned elsewhere (the header file) which
+    // must outlive this object. Contents must be equal.
+    void use_mapped(std::span<const uint8_t> s)
+    {
+        assert(std::ranges::equal(s, raw()));
+        mapped = s;
+        bytes.clear();
+        bytes.shrink_to_fit();
+    }
+    bool is_mapped() const { return mapped.data() != nullptr; }
 
 protected:
+    void own()
+    {
+        if (is_mapped())
+            bytes.assign(mapped.begin(), mapped.end());
+        mapped = {};
+    }
     friend class HeaderVecRegistry;
     std::vector<uint8_t> bytes;
+    std::span<const uint8_t> mapped;
 };
 
 class Batch : public Headervec {
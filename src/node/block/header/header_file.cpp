@@ -0,0 +1,79 @@
+#include "header_file.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+HeaderFile::HeaderFile(const std::string& path)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open header file \"" + path + "\": " + strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat header file \"" + path + "\": " + strerror(errno));
+    }
+    // drop partially written batch
+    nSlots = std::min(size_t(st.st_size) / batchBytes, maxSlots);
+    auto m { ftruncate(fd, off_t(nSlots * batchBytes)) == 0
+            ? mmap(nullptr, mapBytes, PROT_READ, MAP_SHARED, fd, 0)
+            : MAP_FAILED };
+    if (m == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map header file \"" + path + "\": " + strerror(errno));
+    }
+    map = static_cast<const uint8_t*>(m);
+}
+
+HeaderFile::~HeaderFile()
+{
+    munmap(const_cast<uint8_t*>(map), mapBytes);
+    ::close(fd);
+}
+
+auto HeaderFile::append(std::span<const uint8_t> batch) -> std::optional<std::span<const uint8_t>>
+{
+    assert(batch.size() == batchBytes);
+    if (nSlots == maxSlots)
+        return {};
+    const off_t offset { off_t(nSlots * batchBytes) };
+    for (size_t written = 0; written < batch.size();) {
+        auto n { pwrite(fd, batch.data() + written, batch.size() - written, offset + written) };
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return {}; // partial write is overwritten or dropped on restart
+        }
+        written += n;
+    }
+    nSlots += 1;
+    return at(Batchslot(nSlots - 1));
+}
+
+bool HeaderFile::truncate(Batchslot s)
+{
+    assert(s.index() <= nSlots);
+    if (ftruncate(fd, off_t(s.index() * batchBytes)) != 0)
+        return false;
+    nSlots = s.index();
+    return true;
+}
+#else
+HeaderFile::HeaderFile(const std::string&)
+{
+    throw std::runtime_error("Header file is not supported on this platform");
+}
+HeaderFile::~HeaderFile() { }
+auto HeaderFile::append(std::span<const uint8_t>) -> std::optional<std::span<const uint8_t>>
+{
+    return {};
+}
+bool HeaderFile::truncate(Batchslot) { return false; }
+#endif
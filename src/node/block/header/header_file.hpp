@@ -0,0 +1,36 @@
+#pragma once
+#include "block/chain/batch_slot.hpp"
+#include "block/header/view.hpp"
+#include <optional>
+#include <span>
+#include <string>
+
+// Append-only file of complete header batches, batch i is stored at offset
+// i * batchBytes. The whole file is memory mapped once with a fixed size
+// such that addresses stay valid while the file grows.
+class HeaderFile {
+public:
+    static constexpr size_t batchBytes { HEADERBATCHSIZE * HeaderView::bytesize };
+    static constexpr size_t mapBytes { size_t(1) << 32 }; // address space reserved
+    static constexpr size_t maxSlots { mapBytes / batchBytes };
+
+    HeaderFile(const std::string& path);
+    HeaderFile(const HeaderFile&) = delete;
+    ~HeaderFile();
+
+    size_t slots() const { return nSlots; }
+    std::span<const uint8_t> at(Batchslot s) const
+    {
+        assert(s.index() < nSlots);
+        return { map + s.index() * batchBytes, batchBytes };
+    }
+    // returns the mapped copy, nothing if the batch could not be written
+    std::optional<std::span<const uint8_t>> append(std::span<const uint8_t> batch);
+    // discards slots from s on, these must not be referenced anymore
+    [[nodiscard]] bool truncate(Batchslot s);
+
+private:
+    int fd { -1 };
+    const uint8_t* map { nullptr };
+    size_t nSlots { 0 };
+};
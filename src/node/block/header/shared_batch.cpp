@@ -1,4 +1,5 @@
 #include "block/chain/consensus_headers.hpp"
+#include "spdlog/spdlog.h"
 
 SharedBatch::~SharedBatch()
 {
@@ -69,6 +70,18 @@ HeaderVerifier SharedBatch::verifier() const
     return *this;
 }
 
+void BatchRegistry::open_header_file(const std::string& path)
+{
+    std::unique_lock l(m);
+    assert(headers.empty());
+    try {
+        headerFile = std::make_unique<HeaderFile>(path);
+        mappedInUse.assign(headerFile->slots(), false);
+    } catch (const std::runtime_error& e) {
+        spdlog::warn("{}, keeping headers in memory", e.what());
+    }
+}
+
 SharedBatch BatchRegistry::share(Batch&& headerbatch, const SharedBatch& prev)
 {
     assert(headerbatch.complete());
@@ -84,6 +97,7 @@ SharedBatch BatchRegistry::share(Batch&& headerbatch, const SharedBatch& prev, W
     auto iter = headers.find(key);
     if (iter == headers.end()) {
         // check prevalid
+        map_to_file(headerbatch, prev.valid() ? prev.slot().value() + 1 : Batchslot(0), prev);
         return headers.try_emplace(
                           key,
                           *this, std::move(headerbatch), totalWork, SharedBatch(prev.data.iter))
@@ -138,6 +152,8 @@ void BatchRegistry::dec_ref(SharedBatch::iter_type iter)
         nd.refcount -= 1;
         if (nd.refcount > 0)
             break;
+        if (nd.batch.is_mapped())
+            mappedInUse[nd.slot.index()] = false;
         auto tmp = nd.prev.data;
         nd.prev.data.raw = 0;
         headers.erase(iter);
@@ -147,6 +163,34 @@ void BatchRegistry::dec_ref(SharedBatch::iter_type iter)
     }
 }
 
+void BatchRegistry::map_to_file(Batch& b, Batchslot s, const SharedBatch& prev)
+{
+    if (!headerFile)
+        return;
+    const size_t i { s.index() };
+    if (i > 0 && !prev.getBatch().is_mapped())
+        return; // does not extend the chain in the header file
+
+    if (i < headerFile->slots()) {
+        auto mapped { headerFile->at(s) };
+        if (std::ranges::equal(mapped, b.raw())) {
+            b.use_mapped(mapped);
+            mappedInUse[i] = true;
+            return;
+        }
+        // diverging, can only drop the file's chain from here if unused
+        if (std::find(mappedInUse.begin() + i, mappedInUse.end(), true) != mappedInUse.end())
+            return;
+        if (!headerFile->truncate(s))
+            return;
+        mappedInUse.resize(i);
+    }
+    if (auto mapped { headerFile->append(b.raw()) }) {
+        b.use_mapped(*mapped);
+        mappedInUse.push_back(true);
+    }
+}
+
 bool BatchRegistry::verify(SharedBatchView v, const SignedSnapshot& ss)
 {
     if (!v.valid())
@@ -1,6 +1,8 @@
 #pragma once
 #include "batch.hpp"
 #include "block/chain/worksum.hpp"
+#include "header_file.hpp"
+#include <memory>
 #include <mutex>
 
 class BatchRegistry;
@@ -172,6 +174,9 @@ public:
     {
         assert(headers.size() == 0);
     }
+    // complete batches extending the chain stored in the header file are
+    // read from its memory map instead of the heap
+    void open_header_file(const std::string& path);
     [[nodiscard]] SharedBatch share(Batch&& headerbatch, const SharedBatch& prev);
     [[nodiscard]] SharedBatch share(Batch&& headerbatch, const SharedBatch& prev, Worksum totalWork);
     std::optional<SharedBatch> find_last(const Grid g, const std::optional<SignedSnapshot>&);
@@ -181,9 +186,12 @@ private: // private methods
     template <typename T>
     SharedBatchView find_last_template(const T& batches);
     void dec_ref(SharedBatch::iter_type iter);
+    void map_to_file(Batch&, Batchslot, const SharedBatch& prev);
     bool verify(SharedBatchView, const SignedSnapshot&);
 
 private: // private data
     std::recursive_mutex m;
     Maptype headers;
+    std::unique_ptr<HeaderFile> headerFile;
+    std::vector<bool> mappedInUse; // per header file slot
 };
@@ -0,0 +1,194 @@
+#include "event_feed.hpp"
+#include "block/block.hpp"
+#include "block/body/primitives.hpp"
+#include "general/byte_order.hpp"
+#include "general/reader.hpp"
+#include "general/writer.hpp"
+#include "spdlog/spdlog.h"
+#include <stdexcept>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t maxPending { 64 * 1024 * 1024 }; // unflushed bytes before the feed is stopped
+}
+
+#ifndef _WIN32
+namespace {
+bool pwrite_all(int fd, const std::vector<uint8_t>& v, uint64_t offset)
+{
+    for (size_t written = 0; written < v.size();) {
+        auto n { pwrite(fd, v.data() + written, v.size() - written, offset + written) };
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
+
+template <typename T>
+std::optional<T> pread_int(int fd, uint64_t offset)
+{
+    T t;
+    if (pread(fd, &t, sizeof(t), offset) != sizeof(t))
+        return {};
+    if constexpr (sizeof(T) == 8)
+        return ntoh64(t);
+    else
+        return ntoh32(t);
+}
+}
+
+EventFeed::EventFeed(const std::string& path)
+    : path(path)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    idxfd = ::open((path + ".idx").c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat st, idxst;
+    if (fd < 0 || idxfd < 0 || fstat(fd, &st) != 0 || fstat(idxfd, &idxst) != 0) {
+        auto err { std::string(strerror(errno)) };
+        ::close(fd);
+        ::close(idxfd);
+        throw std::runtime_error("Cannot open event feed \"" + path + "\": " + err);
+    }
+
+    // drop records that were not completely written
+    for (nextSeq = idxst.st_size / 8; nextSeq > 0; --nextSeq) {
+        auto offset { pread_int<uint64_t>(idxfd, (nextSeq - 1) * 8) };
+        if (!offset)
+            continue;
+        auto size { pread_int<uint32_t>(fd, *offset) };
+        if (size && *offset + 4 + *size <= uint64_t(st.st_size)) {
+            end = *offset + 4 + *size;
+            break;
+        }
+    }
+    if (ftruncate(fd, end) != 0 || ftruncate(idxfd, nextSeq * 8) != 0)
+        spdlog::warn("Cannot truncate event feed \"{}\": {}", path, strerror(errno));
+    spdlog::info("Event feed \"{}\" continues at sequence number {}", path, nextSeq);
+}
+
+EventFeed::~EventFeed()
+{
+    ::close(fd);
+    ::close(idxfd);
+}
+
+void EventFeed::scan_chain_records(const std::function<bool(const ChainRecord&)>& proceed) const
+{
+    for (uint64_t seq = nextSeq; seq > 0; --seq) {
+        auto offset { pread_int<uint64_t>(idxfd, (seq - 1) * 8) };
+        if (!offset)
+            return;
+        std::array<uint8_t, 4 + 8 + 1 + 4 + 80> buf;
+        auto n { pread(fd, buf.data(), buf.size(), *offset) };
+        if (n < 4 + 8 + 1 + 4)
+            return;
+        Reader r(std::span(buf.data(), size_t(n)));
+        r.skip(4 + 8);
+        auto type { r.uint8() };
+        if (type == BlockAppend) {
+            Height h { r.uint32() };
+            if (!proceed({ BlockAppend, h, Header(r.view<80>()) }))
+                return;
+        } else if (type == Rollback) {
+            if (!proceed({ Rollback, Height(r.uint32()), {} }))
+                return;
+        }
+    }
+}
+
+bool EventFeed::write_pending()
+{
+    return pwrite_all(fd, records, end) && pwrite_all(idxfd, offsets, nextSeq * 8);
+}
+#else
+EventFeed::EventFeed(const std::string&)
+{
+    throw std::runtime_error("Event feed is not supported on this platform");
+}
+EventFeed::~EventFeed() { }
+void EventFeed::scan_chain_records(const std::function<bool(const ChainRecord&)>&) const { }
+bool EventFeed::write_pending() { return false; }
+#endif
+
+void EventFeed::add_record(Type type, size_t payloadSize, auto writePayload)
+{
+    if (stopped)
+        return;
+    const uint64_t offset { end + records.size() };
+    offsets.resize(offsets.size() + 8);
+    Writer(offsets.data() + offsets.size() - 8, 8) << offset;
+
+    const size_t size { 4 + 8 + 1 + payloadSize };
+    records.resize(records.size() + size);
+    Writer w(records.data() + records.size() - size, size);
+    w << uint32_t(size - 4) << (nextSeq + offsets.size() / 8 - 1) << uint8_t(type);
+    writePayload(w);
+    assert(w.remaining() == 0);
+}
+
+void EventFeed::flush()
+{
+    if (records.empty())
+        return;
+    if (write_pending()) {
+        end += records.size();
+        nextSeq += offsets.size() / 8;
+        records.clear();
+        offsets.clear();
+        return;
+    }
+    // Keep the records, partially written data is overwritten by the
+    // retry. Numbering never continues past records that were not written.
+    spdlog::error("Cannot write to event feed \"{}\", retrying with the next event: {}", path, strerror(errno));
+    if (records.size() > maxPending) {
+        stopped = true;
+        records.clear();
+        offsets.clear();
+        spdlog::error("Event feed \"{}\" stopped at sequence number {}, it is reconciled with the chain on restart", path, nextSeq);
+    }
+}
+
+void EventFeed::block_append(const Block& b)
+{
+    add_record(BlockAppend, 4 + 80 + b.body.serialized_size(), [&](Writer& w) {
+        w << b.height << Range(b.header) << b.body;
+    });
+    flush();
+}
+
+void EventFeed::rollback(Height length)
+{
+    add_record(Rollback, 4, [&](Writer& w) {
+        w << length;
+    });
+    flush();
+}
+
+void EventFeed::mempool(const mempool::Log& log)
+{
+    for (auto& action : log) {
+        std::visit([&]<typename T>(const T& a) {
+            if constexpr (std::is_same_v<T, mempool::Put>) {
+                auto& [txid, value] { a.entry };
+                add_record(MempoolPut, TransferTxExchangeMessage::bytesize + 32, [&](Writer& w) {
+                    w << TransferTxExchangeMessage(txid, value) << Range(value.hash);
+                });
+            } else {
+                add_record(MempoolErase, TransactionId::bytesize, [&](Writer& w) {
+                    w << a.id;
+                });
+            }
+        },
+            action);
+    }
+    flush();
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "block/chain/height.hpp"
+#include "block/header/header.hpp"
+#include "mempool/log.hpp"
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+struct Block;
+class Writer;
+
+// Append-only binary log of chain and mempool events for indexers on the
+// same host. Records of one event are written with a single write() call:
+//
+//   uint32 size (of the remaining record bytes)
+//   uint64 sequence number, starting at 0
+//   uint8  type
+//   payload:
+//     BlockAppend:  uint32 height, 80 byte header, uint32 body size, body
+//     Rollback:     uint32 new chain length
+//     MempoolPut:   transfer as in TxrepMsg, 32 byte transaction hash
+//     MempoolErase: transaction id as in TxnotifyMsg
+//
+// All integers are in network byte order. The index file <path>.idx holds
+// the file offset of record i as uint64 at position 8 * i, so consumers can
+// start tailing at any sequence number. Index entries are written after
+// their record. Records that cannot be written are retried with the next
+// event. If too many pile up, the feed stops until the node is restarted
+// and reconciles it with the chain.
+class EventFeed {
+public:
+    enum Type : uint8_t {
+        BlockAppend = 1,
+        Rollback = 2,
+        MempoolPut = 3,
+        MempoolErase = 4
+    };
+    EventFeed(const std::string& path);
+    EventFeed(const EventFeed&) = delete;
+    ~EventFeed();
+
+    void block_append(const Block&);
+    void rollback(Height length);
+    void mempool(const mempool::Log&);
+    uint64_t next_sequence() const { return nextSeq; }
+
+    // BlockAppend and Rollback records from newest to oldest, used to
+    // reconcile the feed with the chain on startup
+    struct ChainRecord {
+        Type type;
+        Height height; // chain length after this record
+        std::optional<Header> header;
+    };
+    void scan_chain_records(const std::function<bool(const ChainRecord&)>& proceed) const;
+
+private:
+    void add_record(Type, size_t payloadSize, auto writePayload);
+    bool write_pending();
+    void flush();
+
+    std::string path;
+    int fd { -1 };
+    int idxfd { -1 };
+    uint64_t nextSeq { 0 };
+    uint64_t end { 0 }; // file size
+    std::vector<uint8_t> records; // not yet flushed
+    std::vector<uint8_t> offsets; // index entries of these
+    bool stopped { false }; // after too many failed writes
+};
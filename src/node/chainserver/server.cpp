@@ -3,8 +3,10 @@
 #include "block/header/header_impl.hpp"
 #include "eventloop/eventloop.hpp"
 #include "general/hex.hpp"
+#include "general/threads.hpp"
 #include "global/globals.hpp"
 #include "spdlog/spdlog.h"
+#include <algorithm>
 
 bool ChainServer::is_busy()
 
@@ -31,7 +33,8 @@ ConsensusSlave ChainServer::get_chainstate()
 ChainServer::ChainServer(ChainDB& db, BatchRegistry& br, std::optional<SnapshotSigner> snapshotSigner, Token)
     : db(db)
     , batchRegistry(br)
-    , state(db, br, snapshotSigner)
+    , applyWorkers(config().node.applyThreads)
+    , state(db, br, applyWorkers, snapshotSigner)
 {
     worker = std::thread(&ChainServer::workerfun, this);
 }
@@ -63,19 +66,25 @@ void ChainServer::api_put_mempool(PaymentCreateMessage m,
     defer_maybe_busy(PutMempool { std::move(m), std::move(callback) });
 }
 
+void ChainServer::api_put_mempool_batch(std::vector<PaymentCreateMessage> ms,
+    MempoolInsertBatchCb callback)
+{
+    defer_maybe_busy(PutMempoolApiBatch { std::move(ms), std::move(callback) });
+}
+
 void ChainServer::api_get_balance(const API::AccountIdOrAddress& a, BalanceCb callback)
 {
     defer_maybe_busy(GetBalance { a, std::move(callback) });
 }
 
-void ChainServer::api_get_grid(GridCb callback)
+void ChainServer::api_get_balance_at(const API::AccountIdOrAddress& a, Height h, BalanceCb callback)
 {
-    defer_maybe_busy(GetGrid { std::move(callback) });
+    defer_maybe_busy(GetBalanceAt { a, h, std::move(callback) });
 }
 
-void ChainServer::api_get_mempool(MempoolCb callback)
+void ChainServer::api_get_grid(GridCb callback)
 {
-    defer_maybe_busy(GetMempool { std::move(callback) });
+    defer_maybe_busy(GetGrid { std::move(callback) });
 }
 
 void ChainServer::api_lookup_tx(const HashView hash,
@@ -145,6 +154,31 @@ void ChainServer::async_get_blocks(DescriptedBlockRange range, getBlocksCb&& cal
     defer(GetBlocks { range, std::move(callback) });
 }
 
+bool ChainServer::async_prefetch_blocks(DescriptedBlockRange range, getBlocksCb&& callback)
+{
+    std::unique_lock l(mutex);
+    if (prefetches.size() >= maxPrefetches)
+        return false;
+    haswork = true;
+    prefetches.push_back(GetBlocks { range, std::move(callback) });
+    cv.notify_one();
+    return true;
+}
+
+void ChainServer::promote_prefetch(const DescriptedBlockRange& r)
+{
+    std::unique_lock l(mutex);
+    auto iter { std::find_if(prefetches.begin(), prefetches.end(), [&](const GetBlocks& p) {
+        return p.range.descriptor == r.descriptor && p.range.lower == r.lower && p.range.upper == r.upper;
+    }) };
+    if (iter == prefetches.end())
+        return; // already read
+    events.emplace(std::move(*iter));
+    prefetches.erase(iter);
+    haswork = true;
+    cv.notify_one();
+}
+
 void ChainServer::async_stage_request(stage_operation::Operation r)
 {
     std::visit([&](auto req) {
@@ -168,6 +202,7 @@ void ChainServer::close()
 
 void ChainServer::workerfun()
 {
+    setup_thread(ThreadRole::Chainserver);
     // initialization
     while (true) {
         {
@@ -197,11 +232,56 @@ void ChainServer::workerfun()
             }
             timing.reset();
         }
+
+        // full mining templates follow once queued events are processed,
+        // but at latest after maxFullTemplateDelay under steady load
+        if (fullTemplatePending) {
+            std::unique_lock<std::mutex> ul(mutex);
+            const bool idle { events.empty() };
+            ul.unlock();
+            if (idle || std::chrono::steady_clock::now() >= fullTemplateDeadline) {
+                timing = timing_log().session();
+                dispatch_full_mining_templates();
+                timing.reset();
+            }
+        }
+
+        // read-ahead for syncing peers has lowest priority
+        while (true) {
+            std::optional<GetBlocks> p;
+            {
+                std::unique_lock<std::mutex> ul(mutex);
+                if (closing || !events.empty() || prefetches.empty())
+                    break;
+                p.emplace(std::move(prefetches.front()));
+                prefetches.pop_front();
+            }
+            p->callback(state.get_blocks(p->range));
+        }
     }
 }
 
 void ChainServer::dispatch_mining_subscriptions()
 {
+    // reward-only template for the new tip first, such that miners leave
+    // the stale parent without waiting for the mempool body
+    auto t { timing->time("MiningEmpty") };
+    miningSubscriptions.dispatch([&](const Address& a) {
+        return state.mining_task(a, true);
+    });
+    if (config().node.disableTxsMining)
+        return;
+    // keep the deadline of an earlier tip, otherwise frequent tip changes
+    // postpone the full template indefinitely
+    if (!fullTemplatePending)
+        fullTemplateDeadline = std::chrono::steady_clock::now() + maxFullTemplateDelay;
+    fullTemplatePending = true;
+}
+
+void ChainServer::dispatch_full_mining_templates()
+{
+    fullTemplatePending = false;
+    auto t { timing->time("MiningFull") };
     miningSubscriptions.dispatch([&](const Address& a) {
         return state.mining_task(a);
     });
@@ -243,10 +323,11 @@ void ChainServer::handle_event(GetBalance&& e)
     e.callback(result);
 }
 
-void ChainServer::handle_event(GetMempool&& e)
+void ChainServer::handle_event(GetBalanceAt&& e)
 {
-    auto t{timing->time("GetMempool")};
-    e.callback(state.api_get_mempool(2000));
+    auto t{timing->time("GetBalanceAt")};
+    auto current = e.account.visit([&](const auto& t) { return state.api_get_address(t); });
+    e.callback(state.api_get_balance_at(std::move(current), e.height));
 }
 
 void ChainServer::handle_event(LookupTxids&& e)
@@ -363,7 +444,11 @@ void ChainServer::handle_event(stage_operation::StageSetOperation&& r)
 void ChainServer::handle_event(stage_operation::StageAddOperation&& r)
 {
     auto t{timing->time("StageAdd")};
-    auto [stageAddResult, delta] { state.add_stage(r.blocks, r.headers) };
+    const auto begin { std::chrono::steady_clock::now() };
+    const size_t nBlocks { r.blocks.size() };
+    auto [stageAddResult, delta] { state.add_stage(std::move(r.blocks), r.headers) };
+    stageAddResult.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    syncdebug_log().info("StageAdd {} blocks in {} ms", nBlocks, stageAddResult.duration.count() / 1000);
     if (delta) {
         global().pel->async_state_update(std::move(*delta));
         dispatch_mining_subscriptions();
@@ -382,6 +467,14 @@ void ChainServer::handle_event(PutMempool&& e)
     }
 }
 
+void ChainServer::handle_event(PutMempoolApiBatch&& e)
+{
+    auto t{timing->time("PutMempoolApiBatch")};
+    auto [log, res] { state.append_gentxs(e.ms) };
+    global().pel->async_mempool_update(std::move(log));
+    e.callback(res);
+}
+
 void ChainServer::handle_event(PutMempoolBatch&& mb)
 {
     auto t{timing->time("PutMempoolBatch")};
@@ -397,5 +490,6 @@ void ChainServer::handle_event(SetSignedPin&& e)
     auto res { state.apply_signed_snapshot(std::move(e.ss)) };
     if (res) {
         global().pel->async_state_update(std::move(*res));
+        dispatch_mining_subscriptions();
     }
 }
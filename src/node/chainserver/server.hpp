@@ -7,6 +7,7 @@
 #include "communication/stage_operation/request.hpp"
 #include "general/logging.hpp"
 #include "state/state.hpp"
+#include "worker_pool.hpp"
 #include <condition_variable>
 #include <queue>
 #include <thread>
@@ -47,6 +48,10 @@ public:
         PaymentCreateMessage m;
         MempoolInsertCb callback;
     };
+    struct PutMempoolApiBatch {
+        std::vector<PaymentCreateMessage> ms;
+        MempoolInsertBatchCb callback;
+    };
     struct GetGrid {
         GridCb callback;
     };
@@ -54,8 +59,10 @@ public:
         API::AccountIdOrAddress account;
         BalanceCb callback;
     };
-    struct GetMempool {
-        MempoolCb callback;
+    struct GetBalanceAt {
+        API::AccountIdOrAddress account;
+        Height height;
+        BalanceCb callback;
     };
     struct LookupTxids {
         Height maxHeight;
@@ -121,9 +128,10 @@ public:
     using Event = std::variant<
         MiningAppend,
         PutMempool,
+        PutMempoolApiBatch,
         GetGrid,
         GetBalance,
-        GetMempool,
+        GetBalanceAt,
         LookupTxids,
         LookupTxHash,
         LookupLatestTxs,
@@ -154,12 +162,23 @@ private:
         cv.notify_one();
     }
 
+    template <typename T>
+    static void reply_switching(T& e)
+    {
+        e.callback(tl::make_unexpected(ESWITCHING));
+    }
+    static void reply_switching(PutMempoolApiBatch& e)
+    {
+        std::vector<tl::expected<TxHash, int32_t>> res(e.ms.size(), tl::make_unexpected(ESWITCHING));
+        e.callback(res);
+    }
+
     template <typename T>
     void defer_maybe_busy(T&& e)
     {
         std::unique_lock l(mutex);
         if (switching)
-            e.callback(tl::make_unexpected(ESWITCHING));
+            reply_switching(e);
         else {
             haswork = true;
             events.emplace(std::forward<T>(e));
@@ -188,9 +207,10 @@ public:
     void api_mining_append(Block&&, ResultCb);
     // void api_put_mempool(PaymentCreateMessage, ResultCb cb);
     void api_put_mempool(PaymentCreateMessage, MempoolInsertCb cb);
+    void api_put_mempool_batch(std::vector<PaymentCreateMessage>, MempoolInsertBatchCb cb);
     void api_get_balance(const API::AccountIdOrAddress& a, BalanceCb callback);
+    void api_get_balance_at(const API::AccountIdOrAddress& a, Height, BalanceCb callback);
     void api_get_grid(GridCb);
-    void api_get_mempool(MempoolCb callback);
     void api_lookup_tx(const HashView hash, TxCb callback);
     void api_lookup_latest_txs(LatestTxsCb callback);
     void api_get_history(const Address& address, uint64_t beforeId, HistoryCb callback);
@@ -205,6 +225,10 @@ public:
 
     void async_set_signed_checkpoint(SignedSnapshot);
     void async_get_blocks(DescriptedBlockRange, getBlocksCb&&);
+    // processed only when idle, returns false if queue is full
+    bool async_prefetch_blocks(DescriptedBlockRange, getBlocksCb&&);
+    // moves a queued prefetch to the ordinary queue once a peer requests it
+    void promote_prefetch(const DescriptedBlockRange&);
 
     void async_stage_request(stage_operation::Operation);
 
@@ -213,15 +237,17 @@ private:
     ChainError apply_stage(ChainDBTransaction&& t);
     void workerfun();
     void dispatch_mining_subscriptions();
+    void dispatch_full_mining_templates();
 
     TxHash append_gentx(const PaymentCreateMessage&);
 
 private:
     void handle_event(MiningAppend&&);
     void handle_event(PutMempool&&);
+    void handle_event(PutMempoolApiBatch&&);
     void handle_event(GetGrid&&);
     void handle_event(GetBalance&&);
-    void handle_event(GetMempool&&);
+    void handle_event(GetBalanceAt&&);
     void handle_event(LookupTxids&&);
     void handle_event(LookupTxHash&&);
     void handle_event(LookupLatestTxs&&);
@@ -245,6 +271,7 @@ private:
     std::condition_variable cv;
     ChainDB& db;
     BatchRegistry& batchRegistry;
+    chainserver::WorkerPool applyWorkers; // recover transfer signatures of large blocks
 
     // state variables
     chainserver::State state;
@@ -253,12 +280,17 @@ private:
     // mutex protected variables
     std::mutex mutex;
     std::queue<Event> events;
+    static constexpr size_t maxPrefetches { 32 };
+    std::deque<GetBlocks> prefetches;
     MiningSubscriptions miningSubscriptions;
 
     //
     bool haswork = false;
     bool closing = false;
     bool switching = false; // doing chain switch?
+    bool fullTemplatePending = false; // only reward-only templates dispatched for current tip
+    static constexpr auto maxFullTemplateDelay { std::chrono::milliseconds(200) };
+    std::chrono::steady_clock::time_point fullTemplateDeadline;
     std::thread worker;
 };
 ;
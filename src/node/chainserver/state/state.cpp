@@ -42,15 +42,76 @@ const BodyContainer& MiningCache::insert(const Address& a, bool disableTxs, Body
     return cache.back().b;
 }
 
-State::State(ChainDB& db, BatchRegistry& br, std::optional<SnapshotSigner> snapshotSigner)
+State::State(ChainDB& db, BatchRegistry& br, WorkerPool& workers, std::optional<SnapshotSigner> snapshotSigner)
     : db(db)
     , batchRegistry(br)
+    , workers(workers)
     , snapshotSigner(std::move(snapshotSigner))
     , signedSnapshot(db.get_signed_snapshot())
     , chainstate(db, br)
     , nextGarbageCollect(std::chrono::steady_clock::now())
     , _miningCache(mining_cache_validity())
 {
+    auto t { db.transaction() };
+    db.set_balance_index(config().node.balanceIndex, chainlength());
+    t.commit();
+    init_event_feed();
+}
+
+void State::init_event_feed()
+{
+    auto& path { config().node.eventFeed };
+    if (path.empty())
+        return;
+    try {
+        eventFeed.emplace(path);
+    } catch (const std::runtime_error& e) {
+        spdlog::error("{}, event feed disabled", e.what());
+        return;
+    }
+
+    // Records are written after the database commit, find the last block
+    // of the feed that is still on our chain in case we were interrupted.
+    std::optional<Height> feedLength;
+    std::optional<Height> common;
+    Height limit { std::numeric_limits<uint32_t>::max() };
+    eventFeed->scan_chain_records([&](const EventFeed::ChainRecord& r) {
+        if (!feedLength)
+            feedLength = r.height;
+        if (r.type == EventFeed::Rollback) {
+            limit = std::min(limit, r.height);
+            return true;
+        }
+        if (r.height > limit)
+            return true; // was rolled back later
+        if (get_hash(r.height) == r.header->hash()) {
+            common = r.height;
+            return false;
+        }
+        limit = r.height - 1;
+        return true;
+    });
+    if (!feedLength) { // new feed starts at our chain length
+        eventFeed->rollback(chainlength());
+        return;
+    }
+    Height from { std::min(common.value_or(limit), chainlength()) };
+    if (from < *feedLength)
+        eventFeed->rollback(from);
+    for (auto h { from + 1 }; h <= chainlength(); ++h) {
+        auto p { db.get_block(get_hash(h).value()) };
+        assert(p);
+        p->second.height = h.nonzero_assert();
+        eventFeed->block_append(p->second);
+    }
+}
+
+mempool::Log State::pop_mempool_log()
+{
+    auto log { chainstate.pop_mempool_log() };
+    if (eventFeed)
+        eventFeed->mempool(log);
+    return log;
 }
 
 std::optional<std::pair<NonzeroHeight, Header>> State::get_header(Height h) const
@@ -354,45 +415,42 @@ stage_operation::StageSetResult State::set_stage(Headerchain&& hc)
     return { h };
 }
 
-auto State::add_stage(const std::vector<Block>& blocks, const Headerchain& hc) -> std::pair<stage_operation::StageAddResult, std::optional<StateUpdate>>
+auto State::add_stage(std::vector<VerifiedBlock>&& blocks, const Headerchain& hc) -> std::pair<stage_operation::StageAddResult, std::optional<StateUpdate>>
 {
     if (signedSnapshot && !signedSnapshot->compatible(stage)) {
         return { { { ELEADERMISMATCH, signedSnapshot->height() } }, {} };
     }
 
     assert(blocks.size() > 0);
-    ChainError err { Error(0), blocks.back().height + 1 };
+    ChainError err { Error(0), blocks.back().height() + 1 };
     auto transaction = db.transaction();
 
     assert(hc.length() >= stage.length());
     assert(hc.hash_at(stage.length()) == stage.hash_at(stage.length()));
-    for (auto& b : blocks) {
-        assert(hc.length() >= b.height);
-        assert(hc[b.height] == b.header);
+    for (auto& vb : blocks) {
+        const auto height { vb.height() };
+        assert(hc.length() >= height);
+        assert(hc[height] == vb.header);
 
-        assert(b.height == stage.length() + 1);
+        assert(height == stage.length() + 1);
 
-        auto prepared { stage.prepare_append(signedSnapshot, b.header) };
+        auto prepared { stage.prepare_append(signedSnapshot, vb.header) };
         if (!prepared.has_value()) {
-            err = { prepared.error(), b.height };
+            err = { prepared.error(), height };
             break;
         }
-        BodyView bv(b.body_view());
-        if (b.header.merkleroot() != bv.merkle_root(b.height)) {
-            err = { EMROOT, b.height };
+        // body was parsed and hashed on download
+        if (vb.header.merkleroot() != vb.body.merkle_root()) {
+            err = { EMROOT, height };
             break;
         }
-        if (!bv.valid()) {
-            err = { EINV_BODY, b.height };
-            break;
-        }
-        db.insert_protect(b);
+        db.insert_protect({ height, vb.header, std::move(vb.body).release() });
         stage.append(prepared.value(), batchRegistry);
     }
     if (stage.total_work() > chainstate.headers().total_work()) {
-        auto [error, update, apiBlocks] { apply_stage(std::move(transaction)) };
+        auto [error, update, apiBlocks, applied] { apply_stage(std::move(transaction)) };
 
-        publish_websocket_events(update, apiBlocks);
+        publish_events(update, apiBlocks, applied);
 
         if (error.is_error())
             return { { error }, update };
@@ -464,6 +522,7 @@ RollbackResult State::rollback(const Height newlength) const
     for (auto& p : balanceMap) {
         db.set_balance(p.first, p.second);
     }
+    db.rollback_balance_index(newlength);
     return chainserver::RollbackResult {
         .shrinkLength { newlength },
         .toMempool { std::move(toMempool) },
@@ -473,28 +532,35 @@ RollbackResult State::rollback(const Height newlength) const
     };
 }
 
-void State::publish_websocket_events(const std::optional<StateUpdate>& update, const std::vector<API::Block>& apiBlocks)
+void State::publish_events(const std::optional<StateUpdate>& update, const std::vector<API::Block>& apiBlocks, const std::vector<Block>& applied)
 {
     using Fork = state_update::Fork;
     using RollbackData = state_update::RollbackData;
+    auto rollback = [&](Height l) {
+        http_endpoint().push_event(API::Rollback { l });
+        if (eventFeed)
+            eventFeed->rollback(l);
+    };
     if (update) {
         auto& u { update->chainstateUpdate };
         if (std::holds_alternative<Fork>(u)) {
-            auto& l { std::get<Fork>(u).shrinkLength };
-            http_endpoint().push_event(API::Rollback { l });
+            rollback(std::get<Fork>(u).shrinkLength);
         } else if (std::holds_alternative<RollbackData>(u)) {
             auto& d { std::get<RollbackData>(u).data };
-            if (d.has_value()) {
-                auto& l { d->rollback.shrinkLength };
-                http_endpoint().push_event(API::Rollback { l });
-            }
+            if (d.has_value())
+                rollback(d->rollback.shrinkLength);
         }
     }
-    for (auto& b : apiBlocks) {
+    for (auto& b : apiBlocks)
         http_endpoint().push_event(b);
+    if (eventFeed) {
+        assert(applied.size() == apiBlocks.size());
+        for (auto& b : applied)
+            eventFeed->block_append(b);
     }
 }
-auto State::apply_stage(ChainDBTransaction&& t) -> std::tuple<ChainError, std::optional<StateUpdate>, std::vector<API::Block>>
+
+auto State::apply_stage(ChainDBTransaction&& t) -> std::tuple<ChainError, std::optional<StateUpdate>, std::vector<API::Block>, std::vector<Block>>
 {
     dbCacheValidity += 1;
     assert(!signedSnapshot || signedSnapshot->compatible(stage));
@@ -512,13 +578,13 @@ auto State::apply_stage(ChainDBTransaction&& t) -> std::tuple<ChainError, std::o
             db.delete_bad_block(stage.hash_at(h));
         stage.shrink(error.height() - 1);
         if (stage.total_work_at(error.height() - 1) <= chainstate.headers().total_work()) {
-            return { error, {}, {} };
+            return { error, {}, {}, {} };
         }
     }
     db.set_consensus_work(stage.total_work());
     auto update { tr.commit(*this) };
 
-    return { error, update, apiBlocks };
+    return { error, update, apiBlocks, tr.move_applied_blocks() };
 }
 
 auto State::apply_signed_snapshot(SignedSnapshot&& ssnew) -> std::optional<StateUpdate>
@@ -562,6 +628,12 @@ auto State::apply_signed_snapshot(SignedSnapshot&& ssnew) -> std::optional<State
     db.set_consensus_work(chainstate.headers().total_work());
     db.set_signed_snapshot(*signedSnapshot);
     db_t.commit();
+    if (eventFeed) {
+        if (auto& d { std::get<state_update::RollbackData>(res.chainstateUpdate).data }) {
+            eventFeed->rollback(d->rollback.shrinkLength);
+            eventFeed->mempool(res.mempoolUpdate);
+        }
+    }
 
     return res;
 }
@@ -594,11 +666,13 @@ auto State::append_mined_block(const Block& b) -> StateUpdate
         throw Error(EMINEDDEPRECATED);
     }
 
-    chainserver::BlockApplier e { db, chainstate.headers(), chainstate.txids(), false };
+    chainserver::BlockApplier e { db, chainstate.headers(), chainstate.txids(), workers, false };
     auto apiBlock { e.apply_block(bv, b.header, nextHeight, blockId) };
     http_endpoint().push_event(apiBlock);
     db.set_consensus_work(chainstate.work_with_new_block());
     transaction.commit();
+    if (eventFeed)
+        eventFeed->block_append(b);
 
     std::unique_lock<std::mutex> ul(chainstateMutex);
     auto headerchainAppend = chainstate.append(Chainstate::AppendSingle {
@@ -615,7 +689,7 @@ auto State::append_mined_block(const Block& b) -> StateUpdate
         .chainstateUpdate { state_update::Append {
             headerchainAppend,
             try_sign_chainstate() } },
-        .mempoolUpdate { chainstate.pop_mempool_log() }
+        .mempoolUpdate { pop_mempool_log() }
     };
 }
 
@@ -623,7 +697,7 @@ std::pair<mempool::Log, TxHash> State::append_gentx(const PaymentCreateMessage&
 {
     try {
         auto txhash { chainstate.insert_tx(m) };
-        auto log { chainstate.pop_mempool_log() };
+        auto log { pop_mempool_log() };
         spdlog::info("Added new transaction to mempool");
         return { std::move(log), std::move(txhash) };
     } catch (const Error& e) {
@@ -632,6 +706,23 @@ std::pair<mempool::Log, TxHash> State::append_gentx(const PaymentCreateMessage&
     }
 }
 
+std::pair<mempool::Log, std::vector<tl::expected<TxHash, int32_t>>> State::append_gentxs(const std::vector<PaymentCreateMessage>& ms)
+{
+    std::vector<tl::expected<TxHash, int32_t>> res;
+    res.reserve(ms.size());
+    size_t nAdded { 0 };
+    for (auto& m : ms) {
+        try {
+            res.push_back(chainstate.insert_tx(m));
+            nAdded += 1;
+        } catch (const Error& e) {
+            res.push_back(tl::make_unexpected(e.e));
+        }
+    }
+    spdlog::info("Added {}/{} new transactions to mempool", nAdded, ms.size());
+    return { pop_mempool_log(), std::move(res) };
+}
+
 API::Balance State::api_get_address(AddressView address)
 {
     if (auto p = db.lookup_address(address); p) {
@@ -666,6 +757,18 @@ API::Balance State::api_get_address(AccountId accountId)
     }
 }
 
+auto State::api_get_balance_at(API::Balance current, Height height) -> tl::expected<API::Balance, int32_t>
+{
+    auto begin { db.balance_index_begin() };
+    if (!begin || height < *begin)
+        return tl::make_unexpected(ENOBALANCEINDEX);
+    if (height > chainlength())
+        return tl::make_unexpected(EBADHEIGHT);
+    if (current.address) // otherwise the account never existed
+        current.balance = db.lookup_balance_at(current.accountId, height);
+    return current;
+}
+
 auto State::insert_txs(const TxVec& txs) -> std::pair<std::vector<int32_t>, mempool::Log>
 {
     std::vector<int32_t> res;
@@ -678,7 +781,7 @@ auto State::insert_txs(const TxVec& txs) -> std::pair<std::vector<int32_t>, memp
             res.push_back(e.e);
         }
     }
-    return { res, chainstate.pop_mempool_log() };
+    return { res, pop_mempool_log() };
 }
 
 API::ChainHead State::api_get_head() const
@@ -696,20 +799,6 @@ API::ChainHead State::api_get_head() const
     };
 }
 
-auto State::api_get_mempool(size_t n) -> API::MempoolEntries
-{
-    std::vector<Hash> hashes;
-    auto nextHeight { next_height() };
-    auto entries = chainstate.mempool().get_payments(n, nextHeight, &hashes);
-    assert(hashes.size() == entries.size());
-    API::MempoolEntries out;
-    for (size_t i = 0; i < hashes.size(); ++i) {
-        out.entries.push_back(API::MempoolEntry {
-            entries[i], hashes[i] });
-    }
-    return out;
-}
-
 auto State::api_get_history(Address a, uint64_t beforeId) -> std::optional<API::AccountHistory>
 {
     auto p = db.lookup_address(a);
@@ -811,7 +900,7 @@ auto State::commit_fork(RollbackResult&& rr, AppendBlocksResult&& abr) -> StateU
 
     return StateUpdate {
         .chainstateUpdate { std::move(forkMsg) },
-        .mempoolUpdate { chainstate.pop_mempool_log() },
+        .mempoolUpdate { pop_mempool_log() },
     };
 }
 
@@ -829,7 +918,7 @@ auto State::commit_append(AppendBlocksResult&& abr) -> StateUpdate
                 headerchainAppend,
                 try_sign_chainstate(),
             } },
-        .mempoolUpdate { chainstate.pop_mempool_log() }
+        .mempoolUpdate { pop_mempool_log() }
     };
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 #include "api/types/forward_declarations.hpp"
+#include "block/body/verified.hpp"
 #include "block/chain/range.hpp"
 #include "communication/messages.hpp"
 #include "communication/mining_task.hpp"
+#include "chainserver/event_feed.hpp"
 #include "communication/stage_operation/result.hpp"
 #include "helpers/consensus.hpp"
 #include "helpers/past_chains.hpp"
@@ -13,6 +15,7 @@ struct Block;
 
 class ChainDBTransaction;
 namespace chainserver {
+class WorkerPool;
 struct MiningCache {
     struct CacheValidity {
         int db { 0 };
@@ -53,7 +56,7 @@ class State {
 
 public:
     // constructor/destructor
-    State(ChainDB& b, BatchRegistry&, std::optional<SnapshotSigner> snapshotSigner);
+    State(ChainDB& b, BatchRegistry&, WorkerPool&, std::optional<SnapshotSigner> snapshotSigner);
 
     // concurrent methods
     Batch get_headers_concurrent(BatchSelector selector);
@@ -66,6 +69,7 @@ public:
     auto mining_task(const Address& a, bool disableTxs) -> tl::expected<ChainMiningTask, Error>;
 
     auto append_gentx(const PaymentCreateMessage&) -> std::pair<mempool::Log, TxHash>;
+    auto append_gentxs(const std::vector<PaymentCreateMessage>&) -> std::pair<mempool::Log, std::vector<tl::expected<TxHash, int32_t>>>;
     auto chainlength() const -> Height { return chainstate.headers().length(); }
 
     // mempool
@@ -73,7 +77,7 @@ public:
 
     // stage methods
     auto set_stage(Headerchain&& hc) -> stage_operation::StageSetResult;
-    auto add_stage(const std::vector<Block>& blocks, const Headerchain&) -> std::pair<stage_operation::StageAddResult, std::optional<StateUpdate>>;
+    auto add_stage(std::vector<VerifiedBlock>&& blocks, const Headerchain&) -> std::pair<stage_operation::StageAddResult, std::optional<StateUpdate>>;
 
     // synced state notification
     void set_sync_state(bool synced)
@@ -96,10 +100,10 @@ public:
     // api getters
     auto api_get_address(AddressView) -> API::Balance;
     auto api_get_address(AccountId) -> API::Balance;
+    auto api_get_balance_at(API::Balance current, Height) -> tl::expected<API::Balance, int32_t>;
     auto api_get_head() const -> API::ChainHead;
     auto api_get_history(Address a, uint64_t beforeId) -> std::optional<API::AccountHistory>;
     auto api_get_richlist(size_t N) -> API::Richlist;
-    auto api_get_mempool(size_t) -> API::MempoolEntries;
     auto api_get_tx(HashView hash) const -> std::optional<API::Transaction>;
     auto api_get_latest_txs(size_t N = 100) const -> API::TransactionsByBlocks;
     auto api_get_header(API::HeightOrHash& h) const -> std::optional<std::pair<NonzeroHeight, Header>>;
@@ -107,7 +111,9 @@ public:
     auto api_tx_cache() const -> const TransactionIds;
 
 private:
-    void publish_websocket_events(const std::optional<StateUpdate>&, const std::vector<API::Block>&);
+    void publish_events(const std::optional<StateUpdate>&, const std::vector<API::Block>&, const std::vector<Block>& applied);
+    void init_event_feed();
+    mempool::Log pop_mempool_log();
 
     // delegated getters
     auto api_get_block(Height h) const -> std::optional<API::Block>;
@@ -115,7 +121,7 @@ private:
     NonzeroHeight next_height() const { return (chainlength() + 1).nonzero_assert(); }
 
     // transactions
-    [[nodiscard]] auto apply_stage(ChainDBTransaction&& t) -> std::tuple<ChainError, std::optional<StateUpdate>, std::vector<API::Block>>;
+    [[nodiscard]] auto apply_stage(ChainDBTransaction&& t) -> std::tuple<ChainError, std::optional<StateUpdate>, std::vector<API::Block>, std::vector<Block>>;
 
 public:
     [[nodiscard]] auto apply_signed_snapshot(SignedSnapshot&& sp) -> std::optional<StateUpdate>;
@@ -136,6 +142,7 @@ private:
     using tp = std::chrono::steady_clock::time_point;
     ChainDB& db;
     BatchRegistry& batchRegistry;
+    WorkerPool& workers;
 
     std::optional<SnapshotSigner> snapshotSigner;
     std::optional<SignedSnapshot> signedSnapshot;
@@ -152,5 +159,6 @@ private:
     std::chrono::steady_clock::time_point nextGarbageCollect;
 
     MiningCache _miningCache;
+    std::optional<EventFeed> eventFeed;
 };
 }
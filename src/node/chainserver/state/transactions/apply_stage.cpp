@@ -20,7 +20,7 @@ ApplyStageTransaction::ApplyStageTransaction(const State& s, ChainDBTransaction&
     applyResult = AppendBlocksResult {};
     auto& res { applyResult.value() };
     auto& baseTxIds { rb ? rb->chainTxIds : ccs.chainstate.txids() };
-    chainserver::BlockApplier ba { ccs.db, ccs.stage, baseTxIds, true };
+    chainserver::BlockApplier ba { ccs.db, ccs.stage, baseTxIds, ccs.workers, true };
     std::vector<API::Block> apiBlocks;
     for (NonzeroHeight h = (chainlength + 1).nonzero_assert(); h <= ccs.stage.length(); ++h) {
         auto historyId { ccs.db.next_history_id() };
@@ -50,6 +50,10 @@ ApplyStageTransaction::ApplyStageTransaction(const State& s, ChainDBTransaction&
         res.newHistoryOffsets.push_back(historyId);
         res.newAccountOffsets.push_back(accountId);
         chainlength = h;
+        if (ccs.eventFeed) {
+            b.height = h;
+            appliedBlocks.push_back(std::move(b));
+        }
     }
     res.newTxIds = ba.move_new_txids();
     res.balanceUpdates = ba.move_balance_updates();
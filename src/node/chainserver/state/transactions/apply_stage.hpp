@@ -1,5 +1,6 @@
 #pragma once
 #include "../state.hpp"
+#include "block/block.hpp"
 #include "db/chain_db.hpp"
 #include "api/types/forward_declarations.hpp"
 
@@ -12,6 +13,7 @@ public:
     void consider_rollback(Height shrinkLength);
     [[nodiscard]] std::pair<std::vector<API::Block>,ChainError> apply_stage_blocks();
     [[nodiscard]] StateUpdate commit(State&);
+    [[nodiscard]] std::vector<Block> move_applied_blocks() { return std::move(appliedBlocks); }
 
 private:
     const State& ccs; // const ref
@@ -19,6 +21,7 @@ private:
     Height chainlength;
     std::optional<RollbackResult> rb;
     std::optional<AppendBlocksResult> applyResult;
+    std::vector<Block> appliedBlocks; // kept for the event feed only
 
     bool commited = false;
 };
@@ -4,6 +4,7 @@
 #include "block/body/rollback.hpp"
 #include "block/chain/header_chain.hpp"
 #include "block/chain/history/history.hpp"
+#include "chainserver/worker_pool.hpp"
 #include "db/chain_db.hpp"
 
 namespace {
@@ -203,6 +204,31 @@ struct HistoryEntries {
     std::vector<std::pair<AccountId, HistoryId>> insertAccountHistory;
 };
 
+// Signature recovery dominates block application and is independent per
+// transfer. Large blocks recover on the chain server's worker pool, errors
+// are kept per transfer such that the caller can rethrow them in block order.
+struct RecoveredTransfer {
+    std::optional<VerifiedTransfer> verified;
+    std::exception_ptr error;
+};
+
+std::vector<RecoveredTransfer> recover_transfers(const std::vector<TransferInternal>& transfers,
+    const Headerchain& hc, NonzeroHeight height, chainserver::WorkerPool& workers)
+{
+    constexpr size_t minPerThread { 16 };
+    std::vector<RecoveredTransfer> out(transfers.size());
+    workers.parallel_for(
+        transfers.size(), [&](size_t i) {
+            try {
+                out[i].verified.emplace(transfers[i].verify(hc, height));
+            } catch (...) {
+                out[i].error = std::current_exception();
+            }
+        },
+        transfers.size() / minPerThread);
+    return out;
+}
+
 } // namespace
 
 namespace chainserver {
@@ -315,8 +341,13 @@ Preparation BlockApplier::Preparer::prepare(const BodyView& bv, const NonzeroHei
             .amount { r.amount },
         });
     }
-    for (auto& tr : balanceChecker.get_transfers()) {
-        auto verified { tr.verify(hc, height) };
+    auto& transfers { balanceChecker.get_transfers() };
+    auto recovered { recover_transfers(transfers, hc, height, workers) };
+    for (size_t i = 0; i < transfers.size(); ++i) {
+        auto& tr { transfers[i] };
+        if (recovered[i].error)
+            std::rethrow_exception(recovered[i].error);
+        auto& verified { *recovered[i].verified };
         TransactionId tid { verified.id };
 
         // check for duplicate txid (also within current block)
@@ -352,16 +383,22 @@ API::Block BlockApplier::apply_block(const BodyView& bv, HeaderView hv, NonzeroH
     try {
         preparer.newTxIds.merge(std::move(prepared.txset));
 
+        const bool indexBalances { db.balance_index_begin().has_value() };
+
         // update old balances
         for (auto& [accId, bal] : prepared.updateBalances) {
             db.set_balance(accId, bal);
             balanceUpdates.insert_or_assign(accId, bal);
+            if (indexBalances)
+                db.insert_balance_checkpoint(accId, height, bal);
         }
 
         // insert new balances
         for (auto& [addr, bal, accId] : prepared.insertBalances) {
             db.insertStateEntry(addr, bal, accId);
             balanceUpdates.insert_or_assign(accId, bal);
+            if (indexBalances)
+                db.insert_balance_checkpoint(accId, height, bal);
         }
 
         // write undo data
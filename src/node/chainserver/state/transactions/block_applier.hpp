@@ -9,10 +9,11 @@ class BlockId;
 class HeaderView;
 
 namespace chainserver {
+class WorkerPool;
 struct Preparation;
 struct BlockApplier {
-    BlockApplier(ChainDB& db, const Headerchain& hc, const std::set<TransactionId, ByPinHeight>& baseTxIds, bool fromStage)
-        : preparer { db, hc, baseTxIds, {} }
+    BlockApplier(ChainDB& db, const Headerchain& hc, const std::set<TransactionId, ByPinHeight>& baseTxIds, WorkerPool& workers, bool fromStage)
+        : preparer { db, hc, baseTxIds, workers, {} }
         , db(db)
         , fromStage(fromStage)
     {
@@ -26,6 +27,7 @@ private: // private methods
         const ChainDB& db; // preparer cannot modify db!
         const Headerchain& hc;
         const std::set<TransactionId, ByPinHeight>& baseTxIds;
+        WorkerPool& workers; // recovers transfer signatures
         TransactionIds newTxIds;
         Preparation prepare(const BodyView& bv, const NonzeroHeight height) const;
     };
@@ -0,0 +1,70 @@
+#include "worker_pool.hpp"
+#include "general/threads.hpp"
+
+namespace chainserver {
+
+WorkerPool::WorkerPool(size_t nThreads)
+{
+    for (size_t i = 1; i < nThreads; ++i)
+        threads.emplace_back(&WorkerPool::run, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard l(m);
+        closing = true;
+    }
+    cv.notify_all();
+    for (auto& t : threads)
+        t.join();
+}
+
+void WorkerPool::Job::work()
+{
+    for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;)
+        f(i);
+}
+
+void WorkerPool::parallel_for(size_t n, const std::function<void(size_t)>& f, size_t maxThreads)
+{
+    Job j { f, n, maxThreads };
+    if (maxThreads > 1 && !threads.empty()) {
+        {
+            std::lock_guard l(m);
+            job = &j;
+            generation += 1;
+        }
+        cv.notify_all();
+    }
+    j.work();
+    if (maxThreads > 1 && !threads.empty()) {
+        // helpers that have not joined yet must not see the job anymore
+        std::unique_lock l(m);
+        job = nullptr;
+        cvDone.wait(l, [&] { return active == 0; });
+    }
+}
+
+void WorkerPool::run()
+{
+    setup_thread(ThreadRole::ApplyWorker);
+    std::unique_lock l(m);
+    uint64_t seen { generation };
+    while (true) {
+        cv.wait(l, [&] { return closing || generation != seen; });
+        if (closing)
+            return;
+        seen = generation;
+        if (!job || active + 1 >= job->maxThreads)
+            continue;
+        auto& j { *job };
+        active += 1;
+        l.unlock();
+        j.work();
+        l.lock();
+        if (--active == 0)
+            cvDone.notify_one();
+    }
+}
+}
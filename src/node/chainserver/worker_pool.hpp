@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chainserver {
+
+// Persistent helper threads of the chain server. parallel_for runs on the
+// calling thread together with the helpers and returns when all indices
+// are processed, so only one job is active at a time.
+class WorkerPool {
+public:
+    WorkerPool(size_t nThreads); // including the calling thread
+    WorkerPool(const WorkerPool&) = delete;
+    ~WorkerPool();
+
+    [[nodiscard]] size_t size() const { return threads.size() + 1; }
+
+    // calls f(i) for all i in [0, n) on at most maxThreads threads
+    void parallel_for(size_t n, const std::function<void(size_t)>& f, size_t maxThreads);
+
+private:
+    struct Job {
+        const std::function<void(size_t)>& f;
+        const size_t n;
+        const size_t maxThreads;
+        std::atomic<size_t> next { 0 };
+        void work();
+    };
+    void run();
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::condition_variable cvDone;
+    Job* job { nullptr };
+    uint64_t generation { 0 };
+    size_t active { 0 }; // helpers working on job
+    bool closing { false };
+    std::vector<std::thread> threads;
+};
+}
@@ -0,0 +1,18 @@
+#include "checksum.hpp"
+#include "crypto/crc32c.hpp"
+#include "crypto/hasher_sha256.hpp"
+#include "general/byte_order.hpp"
+#include <cstring>
+
+std::array<uint8_t, 4> message_checksum(ChecksumType t, const uint8_t* data, size_t len)
+{
+    std::array<uint8_t, 4> out;
+    if (t == ChecksumType::CRC32C) {
+        uint32_t c { hton32(crc32c(data, len)) };
+        memcpy(out.data(), &c, 4);
+    } else {
+        auto h { hashSHA256(data, len) };
+        memcpy(out.data(), h.data(), 4);
+    }
+    return out;
+}
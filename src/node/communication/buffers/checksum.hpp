@@ -0,0 +1,14 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Checksum algorithm protecting P2P messages. SHA256 (first 4 bytes) is
+// used with legacy peers, CRC32C is used when both peers announce the
+// capability during handshake.
+enum class ChecksumType : uint8_t {
+    SHA256,
+    CRC32C
+};
+
+[[nodiscard]] std::array<uint8_t, 4> message_checksum(ChecksumType, const uint8_t* data, size_t len);
@@ -1,9 +1,8 @@
 #include "recvbuffer.hpp"
-#include "crypto/hasher_sha256.hpp"
 
-bool Rcvbuffer::verify()
+bool Rcvbuffer::verify(ChecksumType t)
 {
-    auto h = hashSHA256(body.bytes);
+    auto h = message_checksum(t, body.bytes.data(), body.bytes.size());
     if (memcmp(header + 4, h.data(), 4) != 0) {
         return false;
     };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "checksum.hpp"
 #include "communication/messages.hpp"
 #include "general/errors.hpp"
 #include "general/reader.hpp"
@@ -20,7 +21,7 @@ public:
     {
         return readuint32(header);
     }
-    bool verify();
+    bool verify(ChecksumType);
     uint8_t type() { return header[9]; }
     Rcvbuffer() {};
     Rcvbuffer(Rcvbuffer&& buf)
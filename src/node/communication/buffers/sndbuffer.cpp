@@ -1,8 +1,32 @@
 #include "sndbuffer.hpp"
-#include "crypto/hasher_sha256.hpp"
 
-void Sndbuffer::writeChecksum()
+namespace {
+void write_checksum(ChecksumType t, char* ptr, size_t len)
 {
-    auto tmp = hashSHA256(reinterpret_cast<uint8_t*>(ptr.get() + 8), len - 8);
-    memcpy(ptr.get() + 4, tmp.data(), 4);
+    auto c { message_checksum(t, reinterpret_cast<uint8_t*>(ptr + 8), len - 8) };
+    memcpy(ptr + 4, c.data(), 4);
+}
+}
+
+void Sndbuffer::writeChecksum(ChecksumType t)
+{
+    write_checksum(t, ptr.get(), len);
+}
+
+std::shared_ptr<const char[]> SharedSndbuffer::data(ChecksumType t) const
+{
+    auto& slot { t == ChecksumType::CRC32C ? crc32c : sha256 };
+    if (!slot) {
+        std::unique_ptr<char[]> p;
+        if (raw) {
+            p = std::move(raw); // first variant reuses serialized buffer
+        } else {
+            auto& other { t == ChecksumType::CRC32C ? sha256 : crc32c };
+            p.reset(new char[len]);
+            memcpy(p.get(), other.get(), len);
+        }
+        write_checksum(t, p.get(), len);
+        slot = std::move(p);
+    }
+    return slot;
 }
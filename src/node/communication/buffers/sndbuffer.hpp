@@ -1,4 +1,5 @@
 #pragma once
+#include "checksum.hpp"
 #include "general/byte_order.hpp"
 #include <cassert>
 #include <cstring>
@@ -15,8 +16,30 @@ class Sndbuffer {
                 uint32_t n=hton32(len-8);
                 memcpy(ptr.get(),&n,4);
 			}
-        void writeChecksum();
+        void writeChecksum(ChecksumType);
 		uint8_t* msgdata() { return reinterpret_cast<uint8_t*>(ptr.get() + 10); };
 		size_t msgsize() { return len - 10; }
 		size_t fullsize() { return len; }
 };
+
+// Immutable, reference counted message buffer with checksum already written.
+// Used to broadcast the same message to many connections without
+// serializing and hashing it once per connection. The checksummed variant
+// for each checksum type is created lazily on first use, therefore this
+// class must only be used from a single thread.
+class SharedSndbuffer {
+	public:
+		SharedSndbuffer(Sndbuffer&& b)
+			: len(b.fullsize())
+			, raw(std::move(b.ptr))
+		{
+		}
+		std::shared_ptr<const char[]> data(ChecksumType) const;
+		size_t fullsize() const { return len; }
+
+	private:
+		uint32_t len;
+		mutable std::unique_ptr<char[]> raw;
+		mutable std::shared_ptr<const char[]> sha256;
+		mutable std::shared_ptr<const char[]> crc32c;
+};
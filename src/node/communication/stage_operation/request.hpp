@@ -1,6 +1,7 @@
 #pragma once
 
 #include "block/block.hpp"
+#include "block/body/verified.hpp"
 #include "block/chain/header_chain.hpp"
 #include <variant>
 namespace stage_operation {
@@ -11,7 +12,7 @@ struct StageSetOperation {
 
 struct StageAddOperation {
     Headerchain headers;// LATER: remove if no more bugs
-    std::vector<Block> blocks;
+    std::vector<VerifiedBlock> blocks;
 };
 
 using Operation = std::variant<StageSetOperation, StageAddOperation>;
@@ -2,6 +2,7 @@
 #include "block/chain/height.hpp"
 #include "general/errors.hpp"
 #include "chainserver/state/update/update.hpp"
+#include <chrono>
 #include <optional>
 #include <variant>
 namespace stage_operation {
@@ -11,6 +12,7 @@ struct StageSetResult {
 };
 struct StageAddResult {
     ChainError ce;
+    std::chrono::microseconds duration { 0 }; // including database commit
 };
 using Result = std::variant<StageSetResult, StageAddResult>;
 }
@@ -6,6 +6,7 @@
 #include "spdlog/spdlog.h"
 #include "toml++/toml.hpp"
 #include "version.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <limits>
@@ -100,6 +101,29 @@ EndpointAddress fetch_endpointaddress(toml::node& n)
     }
     throw std::runtime_error("Cannot extract configuration value starting at line "s + std::to_string(n.source().begin.line) + ", colum "s + std::to_string(n.source().begin.column) + ".");
 }
+// empty string disables the TCP listener
+std::optional<EndpointAddress> fetch_bind(toml::node& n)
+{
+    if (fetch<std::string>(n).empty())
+        return {};
+    return fetch_endpointaddress(n);
+}
+
+uint32_t fetch_socket_mode(toml::node& n)
+{
+    auto m { fetch<int64_t>(n) };
+    if (m < 0 || m > 0777)
+        throw std::runtime_error("Invalid socket mode at line "s + std::to_string(n.source().begin.line) + ".");
+    return uint32_t(m);
+}
+
+toml::value<int64_t> socket_mode(uint32_t mode)
+{
+    toml::value<int64_t> v { int64_t(mode) };
+    v.flags(toml::value_flags::format_as_octal);
+    return v;
+}
+
 toml::array& array_ref(toml::node& n)
 {
     if (n.is_array()) {
@@ -172,9 +196,9 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
     }
     // copy default values
     std::optional<EndpointAddress> nodeBind;
-    std::optional<EndpointAddress> rpcBind;
     std::optional<EndpointAddress> publicrpcBind;
     std::optional<EndpointAddress> stratumBind;
+    UnixSocketAddress stratumUnixSocket;
     node.isolated = ai.isolated_given;
     node.disableTxsMining = ai.disable_tx_mining_given;
     if (ai.testnet_given) {
@@ -207,6 +231,11 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
         };
     }
 
+    if (is_testnet())
+        jsonrpc.bind = EndpointAddress::parse("127.0.0.1:3100").value();
+    else
+        jsonrpc.bind = EndpointAddress::parse("127.0.0.1:3000").value();
+
     std::string filename = is_testnet() ? "testnet_config.toml" : "config.toml";
     if (!ai.config_given && !std::filesystem::exists(filename)) {
         if (!dmp)
@@ -237,7 +266,11 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
                 } else if (key == "stratum") {
                     for (auto& [k, v] : *t) {
                         if (k == "bind")
-                            stratumBind = fetch_endpointaddress(v);
+                            stratumBind = fetch_bind(v);
+                        else if (k == "unix-socket")
+                            stratumUnixSocket.path = fetch<std::string>(v);
+                        else if (k == "unix-socket-mode")
+                            stratumUnixSocket.mode = fetch_socket_mode(v);
                         else
                             warning_config(k);
                     }
@@ -251,7 +284,11 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
                 } else if (key == "jsonrpc") {
                     for (auto& [k, v] : *t) {
                         if (k == "bind")
-                            rpcBind = fetch_endpointaddress(v);
+                            jsonrpc.bind = fetch_bind(v);
+                        else if (k == "unix-socket")
+                            jsonrpc.unixSocket.path = fetch<std::string>(v);
+                        else if (k == "unix-socket-mode")
+                            jsonrpc.unixSocket.mode = fetch_socket_mode(v);
                         else
                             warning_config(k);
                     }
@@ -271,6 +308,16 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
                             node.isolated = fetch<bool>(v);
                         } else if (k == "disable-tx-mining") {
                             node.disableTxsMining = fetch<bool>(v);
+                        } else if (k == "single-thread") {
+                            node.singleThread = fetch<bool>(v);
+                        } else if (k == "balance-index") {
+                            node.balanceIndex = fetch<bool>(v);
+                        } else if (k == "event-feed") {
+                            node.eventFeed = fetch<std::string>(v);
+                        } else if (k == "capture-traffic") {
+                            node.captureTraffic = fetch<std::string>(v);
+                        } else if (k == "apply-threads") {
+                            node.applyThreads = std::clamp(fetch<int64_t>(v), int64_t(1), int64_t(64));
                         } else if (k == "enable-ban") {
                             peers.enableBan = fetch<bool>(v);
                         } else if (k == "allow-localhost-ip") {
@@ -280,6 +327,25 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
                         } else
                             warning_config(k);
                     }
+                } else if (key == "threads") {
+                    for (auto& [k, v] : *t) {
+                        auto placement { threads.find(k) };
+                        auto tt { v.as_table() };
+                        if (!placement || !tt) {
+                            warning_config(k);
+                            continue;
+                        }
+                        for (auto& [k2, v2] : *tt) {
+                            if (k2 == "cpus") {
+                                placement->cpus.clear();
+                                for (auto& e : array_ref(v2))
+                                    placement->cpus.push_back(fetch<int>(e));
+                            } else if (k2 == "nice") {
+                                placement->nice = fetch<int>(v2);
+                            } else
+                                warning_config(k2);
+                        }
+                    }
                 } else {
                     warning_config(key);
                 }
@@ -323,10 +389,10 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
             std::cerr << "Bad --stratum option '" << ai.rpc_arg << "'.\n";
             return -1;
         };
-        stratumPool = StratumPool { .bind = p.value() };
+        stratumPool = StratumPool { .bind = p.value(), .unixSocket = stratumUnixSocket };
     } else {
-        if (stratumBind) {
-            stratumPool = StratumPool { *stratumBind };
+        if (stratumBind || !stratumUnixSocket.path.empty()) {
+            stratumPool = StratumPool { stratumBind, stratumUnixSocket };
         }
     }
 
@@ -338,15 +404,10 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
             return -1;
         };
         jsonrpc.bind = p.value();
-    } else {
-        if (rpcBind) {
-            jsonrpc.bind = *rpcBind;
-        } else {
-            if (is_testnet())
-                jsonrpc.bind = EndpointAddress::parse("127.0.0.1:3100").value();
-            else
-                jsonrpc.bind = EndpointAddress::parse("127.0.0.1:3000").value();
-        }
+    }
+    if (!jsonrpc.bind && jsonrpc.unixSocket.path.empty()) {
+        std::cerr << "JSON RPC needs either a TCP or a unix socket.\n";
+        return -1;
     }
 
     // JSON Public RPC socket
@@ -392,11 +453,32 @@ int Config::process_gengetopt(gengetopt_args_info& ai)
     return 1;
 }
 
+auto Config::Threads::find(std::string_view role) const -> const ThreadPlacement*
+{
+    if (role == "apply-worker")
+        return &applyWorker;
+    if (role == "chainserver")
+        return &chainserver;
+    if (role == "eventloop")
+        return &eventloop;
+    if (role == "network")
+        return &network;
+    if (role == "peerserver")
+        return &peerserver;
+    if (role == "rpc")
+        return &rpc;
+    if (role == "stratum")
+        return &stratum;
+    return nullptr;
+}
+
 std::string Config::dump()
 {
     toml::table tbl;
     tbl.insert_or_assign("jsonrpc", toml::table {
-                                        { "bind", jsonrpc.bind.to_string() },
+                                        { "bind", jsonrpc.bind ? jsonrpc.bind->to_string() : ""s },
+                                        { "unix-socket", jsonrpc.unixSocket.path },
+                                        { "unix-socket-mode", socket_mode(jsonrpc.unixSocket.mode) },
                                     });
 
     toml::array connect;
@@ -405,7 +487,9 @@ std::string Config::dump()
     }
     tbl.insert_or_assign("stratum",
         toml::table {
-            { "bind", stratumPool ? stratumPool->bind.to_string() : ""s },
+            { "bind", stratumPool && stratumPool->bind ? stratumPool->bind->to_string() : ""s },
+            { "unix-socket", stratumPool ? stratumPool->unixSocket.path : ""s },
+            { "unix-socket-mode", socket_mode(stratumPool ? stratumPool->unixSocket.mode : 0660) },
         });
     tbl.insert_or_assign("node",
         toml::table {
@@ -413,9 +497,30 @@ std::string Config::dump()
             { "connect", connect },
             { "isolated", node.isolated },
             { "disable-tx-mining", node.disableTxsMining },
+            { "single-thread", node.singleThread },
+            { "apply-threads", int64_t(node.applyThreads) },
+            { "balance-index", node.balanceIndex },
+            { "event-feed", node.eventFeed },
+            { "capture-traffic", node.captureTraffic },
             { "enable-ban", peers.enableBan },
             { "allow-localhost-ip", peers.allowLocalhostIp },
             { "log-communication", (bool)node.logCommunication } });
+    toml::table threadsTbl;
+    for (auto role : { "apply-worker", "chainserver", "eventloop", "network", "peerserver", "rpc", "stratum" }) {
+        auto& p { *threads.find(role) };
+        if (p.cpus.empty() && !p.nice)
+            continue;
+        toml::table t;
+        toml::array cpus;
+        for (auto cpu : p.cpus)
+            cpus.push_back(cpu);
+        t.insert_or_assign("cpus", cpus);
+        if (p.nice)
+            t.insert_or_assign("nice", *p.nice);
+        threadsTbl.insert_or_assign(role, t);
+    }
+    if (!threadsTbl.empty())
+        tbl.insert_or_assign("threads", threadsTbl);
     tbl.insert_or_assign("db", toml::table {
                                    { "chain-db", data.chaindb },
                                    { "peers-db", data.peersdb },
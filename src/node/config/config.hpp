@@ -3,6 +3,7 @@
 #include "block/chain/signed_snapshot.hpp"
 #include "general/tcp_util.hpp"
 #include <atomic>
+#include <utility>
 struct gengetopt_args_info;
 struct EndpointVector: public std::vector<EndpointAddress> {
     using vector::vector;
@@ -19,13 +20,15 @@ struct Config {
         std::string peersdb;
     } data;
     struct JSONRPC {
-        EndpointAddress bind;
+        std::optional<EndpointAddress> bind; // empty if only listening on unix socket
+        UnixSocketAddress unixSocket;
     } jsonrpc;
     struct PublicAPI {
         EndpointAddress bind;
     };
     struct StratumPool {
-        EndpointAddress bind;
+        std::optional<EndpointAddress> bind;
+        UnixSocketAddress unixSocket;
     };
     std::optional<PublicAPI> publicAPI;
     std::optional<StratumPool> stratumPool;
@@ -34,8 +37,31 @@ struct Config {
         EndpointAddress bind;
         bool isolated { false };
         bool disableTxsMining { false }; // don't mine transactions
+        bool singleThread { false }; // run eventloop on the libuv networking thread
+        uint32_t applyThreads { 1 }; // threads recovering transfer signatures in large blocks
+        bool balanceIndex { false }; // index balances by height for historical queries
+        std::string eventFeed; // path of local event feed file, empty to disable
+        std::string captureTraffic; // path of inbound P2P traffic capture, empty to disable
         std::atomic<bool> logCommunication { false };
     } node;
+    struct ThreadPlacement {
+        std::vector<int> cpus; // empty means no affinity
+        std::optional<int> nice;
+    };
+    struct Threads {
+        ThreadPlacement applyWorker; // chain server worker pool, see apply-threads
+        ThreadPlacement chainserver;
+        ThreadPlacement eventloop;
+        ThreadPlacement network;
+        ThreadPlacement peerserver;
+        ThreadPlacement rpc;
+        ThreadPlacement stratum;
+        const ThreadPlacement* find(std::string_view role) const;
+        ThreadPlacement* find(std::string_view role)
+        {
+            return const_cast<ThreadPlacement*>(std::as_const(*this).find(role));
+        }
+    } threads;
     struct Peers {
         bool allowLocalhostIp = false; // do not ignore 127.xxx.xxx.xxx peer node addresses provided by peers
         EndpointVector connect;
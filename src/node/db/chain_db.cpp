@@ -22,7 +22,8 @@ ChainDB::Cache ChainDB::Cache::init(SQLite::Database& db)
     return {
         .maxStateId { maxStateId },
         .nextHistoryId = HistoryId{uint64_t(hid)},
-        .deletionKey { 2 }
+        .deletionKey { 2 },
+        .balanceIndexBegin {} // loaded by ChainDB constructor
     };
 }
 
@@ -98,6 +99,15 @@ ChainDB::ChainDB(const std::string& path)
                                    "(`account_id`,`history_id`) VALUES (?,?)")
     , stmtAccountHistoryDeleteFrom(
           db, "DELETE FROM `AccountHistory` WHERE `history_id`>=?")
+    , stmtConsensusDeleteProperty(db, "DELETE FROM \"Consensus\" WHERE `height`=?")
+    , stmtBalanceHistoryInsert(db, "INSERT OR REPLACE INTO `BalanceHistory` "
+                                   "(`account_id`,`height`,`balance`) VALUES (?,?,?)")
+    , stmtBalanceHistorySnapshot(db, "INSERT OR REPLACE INTO `BalanceHistory` "
+                                     "(`account_id`,`height`,`balance`) SELECT `ROWID`,?,`balance` FROM `State`")
+    , stmtBalanceHistoryDeleteFrom(db, "DELETE FROM `BalanceHistory` WHERE `height`>?")
+    , stmtBalanceHistoryClear(db, "DELETE FROM `BalanceHistory`")
+    , stmtBalanceHistoryLookup(db, "SELECT `balance` FROM `BalanceHistory` WHERE "
+                                   "`account_id`=? AND `height`<=? ORDER BY `height` DESC LIMIT 1")
     , stmtBlockIdSelect(
           db, "SELECT `ROWID` FROM `Blocks` WHERE `hash`=?")
     , stmtBlockHeightSelect(
@@ -116,6 +126,9 @@ ChainDB::ChainDB(const std::string& path)
     //
     // Do DELETESCHEDULE cleanup
     db.exec("UPDATE `Deleteschedule` SET `deletion_key`=1");
+
+    if (auto o { stmtConsensusSelect.one(BALANCEINDEXID) }; o.has_value())
+        cache.balanceIndexBegin = Height(readuint32(o.get_array<4>(0).data()));
 }
 
 void ChainDB::insertStateEntry(const AddressView address, Funds balance,
@@ -533,3 +546,46 @@ chainserver::TransactionIds ChainDB::fetch_tx_ids(Height height) const
     }
     return out;
 }
+
+void ChainDB::set_balance_index(bool enable, Height chainLength)
+{
+    if (enable == cache.balanceIndexBegin.has_value())
+        return;
+    if (enable) {
+        stmtBalanceHistorySnapshot.run(chainLength);
+        std::array<uint8_t, 4> a; // blob such that it cannot join with `Blocks`
+        Writer w(a.data(), a.size());
+        w << chainLength;
+        stmtConsensusSetProperty.run(BALANCEINDEXID, a);
+        cache.balanceIndexBegin = chainLength;
+    } else {
+        stmtBalanceHistoryClear.run();
+        stmtConsensusDeleteProperty.run(BALANCEINDEXID);
+        cache.balanceIndexBegin.reset();
+    }
+}
+
+void ChainDB::insert_balance_checkpoint(AccountId accountId, NonzeroHeight height, Funds balance)
+{
+    stmtBalanceHistoryInsert.run(accountId, Height(height), balance);
+}
+
+void ChainDB::rollback_balance_index(Height newLength)
+{
+    if (!cache.balanceIndexBegin)
+        return;
+    stmtBalanceHistoryDeleteFrom.run(newLength);
+    if (newLength < *cache.balanceIndexBegin) {
+        // rolled back below the initial snapshot, take a new one
+        set_balance_index(false, newLength);
+        set_balance_index(true, newLength);
+    }
+}
+
+Funds ChainDB::lookup_balance_at(AccountId accountId, Height height) const
+{
+    auto o { stmtBalanceHistoryLookup.one(accountId, height) };
+    if (!o.has_value())
+        return Funds::zero(); // account did not exist yet
+    return o.get<Funds>(0);
+}
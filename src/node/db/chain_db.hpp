@@ -233,6 +233,7 @@ private:
     // ids to save additional information in tables
     static constexpr int64_t WORKSUMID = -1;
     static constexpr int64_t SIGNEDPINID = -2;
+    static constexpr int64_t BALANCEINDEXID = -3;
 
 public:
     ChainDB(const std::string& path);
@@ -324,6 +325,15 @@ public:
     std::optional<AccountFunds> lookup_address(const AddressView address) const; // for indexing nodes
     std::vector<std::tuple<HistoryId, Hash, std::vector<uint8_t>>> lookup_history_100_desc(AccountId account_id, int64_t beforeId);
 
+    //////////////////////////////
+    // Optional balance index: balance of every account after each block
+    // that changed it, starting with a snapshot of all balances.
+    void set_balance_index(bool enable, Height chainLength);
+    [[nodiscard]] std::optional<Height> balance_index_begin() const { return cache.balanceIndexBegin; }
+    void insert_balance_checkpoint(AccountId, NonzeroHeight, Funds);
+    void rollback_balance_index(Height newLength); // call after balances were reverted
+    [[nodiscard]] Funds lookup_balance_at(AccountId, Height) const;
+
 
 
 private:
@@ -370,12 +380,16 @@ private:
                     "`hash` BLOB NOT NULL, `data` BLOB NOT NULL, PRIMARY KEY(`id`))");
             db.exec("CREATE INDEX IF NOT EXISTS `history_index` ON "
                     "`History` (`hash` ASC)");
+            db.exec("CREATE TABLE IF NOT EXISTS `BalanceHistory` (`account_id` "
+                    "INTEGER, `height` INTEGER, `balance` INTEGER NOT NULL, "
+                    "PRIMARY KEY(`account_id`,`height`)) WITHOUT ROWID");
         }
     } createTables;
     struct Cache {
         AccountId maxStateId;
         HistoryId nextHistoryId;
         DeletionKey deletionKey;
+        std::optional<Height> balanceIndexBegin;
         static Cache init(SQLite::Database& db);
     } cache;
     Statement2 stmtBlockInsert;
@@ -417,6 +431,12 @@ private:
     mutable Statement2 stmtHistoryLookupRange;
     Statement2 stmtAccountHistoryInsert;
     Statement2 stmtAccountHistoryDeleteFrom;
+    Statement2 stmtConsensusDeleteProperty;
+    Statement2 stmtBalanceHistoryInsert;
+    Statement2 stmtBalanceHistorySnapshot;
+    Statement2 stmtBalanceHistoryDeleteFrom;
+    Statement2 stmtBalanceHistoryClear;
+    mutable Statement2 stmtBalanceHistoryLookup;
 
     mutable Statement2 stmtBlockIdSelect;
     mutable Statement2 stmtBlockHeightSelect;
@@ -10,6 +10,12 @@ PeerDB::CreateTables::CreateTables(SQLite::Database& db)
             "`begin` INTEGER NOT NULL, `end` INTEGER DEFAULT NULL, "
             "`code` INTEGER DEFAULT NULL )");
     db.exec("CREATE TABLE IF NOT EXISTS `refuse_log` ( `peer` INTEGER NOT NULL, `timestamp` INTEGER NOT NULL )");
+    db.exec("CREATE TABLE IF NOT EXISTS `connection_stats` ( `peer` INTEGER NOT NULL, "
+            "`day` INTEGER NOT NULL, `connections` INTEGER NOT NULL, "
+            "PRIMARY KEY(`peer`, `day`) ) WITHOUT ROWID");
+    db.exec("CREATE TABLE IF NOT EXISTS `refuse_stats` ( `peer` INTEGER NOT NULL, "
+            "`day` INTEGER NOT NULL, `refusals` INTEGER NOT NULL, "
+            "PRIMARY KEY(`peer`, `day`) ) WITHOUT ROWID");
     db.exec("CREATE INDEX IF NOT EXISTS `bans_index` ON `bans` ( `ban_until` DESC )");
     db.exec(R"SQL(CREATE TABLE IF NOT EXISTS "peers" ( "ipport" INTEGER, "lastseen" INTEGER DEFAULT 0, PRIMARY KEY("ipport")))SQL");
     db.exec(R"SQL(CREATE INDEX IF NOT EXISTS "lastseen_peers" ON "peers" ( "lastseen"))SQL");
@@ -19,7 +25,10 @@ PeerDB::PeerDB(const std::string& path)
     : db(path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE)
     , createTables(db)
     , insertOffense(db, "INSERT INTO `offenses` (`ip`, `timestamp`, `offense`) VALUES (?,?,?) ")
-    , getOffenses(db, "SELECT `ip`, `timestamp`, `offense` FROM `offenses` LIMIT 100 OFFSET ?")
+    // offenses are only appended and pruned from the front, so their ROWIDs
+    // are consecutive and pages can be found without scanning
+    , getOffenses(db, "SELECT `ip`, `timestamp`, `offense` FROM `offenses` "
+                      "WHERE ROWID >= (SELECT min(ROWID) FROM `offenses`) + ? ORDER BY ROWID LIMIT 100")
     , insertPeer(db, "INSERT OR IGNORE INTO `peers` (`ipport`) VALUES (?) ")
     , setlastseen(db, "UPDATE `peers` SET `lastseen`=? WHERE `ipport`=?")
     , selectRecentPeers(db, "SELECT `ipport`, `lastseen` FROM `peers` ORDER BY `lastseen` DESC LIMIT ?")
@@ -35,9 +44,51 @@ PeerDB::PeerDB(const std::string& path)
                      "(?,?)")
     , disconnectset(db, "UPDATE `connection_log` SET `end`=?, `code`=? WHERE ROWID=?")
     , refuseinsert(db, "INSERT INTO `refuse_log` (`peer`,`timestamp`) VALUES (?,?)")
+
+    // log rows are pruned in ROWID chunks from the front
+    , rollupConnections(db, "INSERT INTO `connection_stats` (`peer`, `day`, `connections`) "
+                            "SELECT `peer`, `begin` / 86400, count(*) FROM `connection_log` "
+                            "WHERE ROWID < (SELECT min(ROWID) FROM `connection_log`) + ?2 AND `begin` < ?1 "
+                            "GROUP BY `peer`, `begin` / 86400 "
+                            "ON CONFLICT(`peer`, `day`) DO UPDATE SET `connections` = `connections` + excluded.`connections`")
+    , pruneConnections(db, "DELETE FROM `connection_log` "
+                           "WHERE ROWID < (SELECT min(ROWID) FROM `connection_log`) + ?2 AND `begin` < ?1")
+    , rollupRefusals(db, "INSERT INTO `refuse_stats` (`peer`, `day`, `refusals`) "
+                         "SELECT `peer`, `timestamp` / 86400, count(*) FROM `refuse_log` "
+                         "WHERE ROWID < (SELECT min(ROWID) FROM `refuse_log`) + ?2 AND `timestamp` < ?1 "
+                         "GROUP BY `peer`, `timestamp` / 86400 "
+                         "ON CONFLICT(`peer`, `day`) DO UPDATE SET `refusals` = `refusals` + excluded.`refusals`")
+    , pruneRefusals(db, "DELETE FROM `refuse_log` "
+                        "WHERE ROWID < (SELECT min(ROWID) FROM `refuse_log`) + ?2 AND `timestamp` < ?1")
+    , pruneOffenses(db, "DELETE FROM `offenses` WHERE ROWID <= "
+                        "min((SELECT max(ROWID) FROM `offenses`) - ?1, (SELECT min(ROWID) FROM `offenses`) + ?2)")
 {
 }
 
+bool PeerDB::prune_logs(uint32_t now)
+{
+    const int64_t cutoff { int64_t(now) - logRetention };
+    auto prune = [&](SQLite::Statement& rollup, SQLite::Statement& del) {
+        rollup.bind(1, cutoff);
+        rollup.bind(2, pruneChunk);
+        rollup.exec();
+        rollup.reset();
+        del.bind(1, cutoff);
+        del.bind(2, pruneChunk);
+        auto n { del.exec() };
+        del.reset();
+        return n;
+    };
+    bool more { prune(rollupConnections, pruneConnections) == pruneChunk };
+    more |= prune(rollupRefusals, pruneRefusals) == pruneChunk;
+
+    pruneOffenses.bind(1, maxOffenses);
+    pruneOffenses.bind(2, pruneChunk - 1);
+    more |= pruneOffenses.exec() == pruneChunk;
+    pruneOffenses.reset();
+    return more;
+}
+
 std::vector<std::pair<EndpointAddress, uint32_t>> PeerDB::recent_peers(int64_t maxEntries)
 {
     std::vector<std::pair<EndpointAddress, uint32_t>> out;
@@ -13,6 +13,11 @@ private:
     // ids to save additional information in tables
     static constexpr int64_t WORKSUMID = -1;
 
+    // log rows older than this are rolled up into per day counts
+    static constexpr uint32_t logRetention { 14 * 24 * 60 * 60 };
+    static constexpr int64_t maxOffenses { 10000 };
+    static constexpr int64_t pruneChunk { 2000 }; // rows per table and prune call
+
 public:
     struct BanEntry {
         IPv4 ip;
@@ -117,6 +122,8 @@ public:
         getOffenses.reset();
         return out;
     }
+    // returns whether more rows are left to prune
+    bool prune_logs(uint32_t now);
     void reset_bans()
     {
         stmtResetBans.exec();
@@ -144,4 +151,9 @@ private:
     SQLite::Statement connectset;
     SQLite::Statement disconnectset;
     SQLite::Statement refuseinsert;
+    SQLite::Statement rollupConnections;
+    SQLite::Statement pruneConnections;
+    SQLite::Statement rollupRefusals;
+    SQLite::Statement pruneRefusals;
+    SQLite::Statement pruneOffenses;
 };
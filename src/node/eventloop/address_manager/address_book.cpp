@@ -0,0 +1,148 @@
+#include "address_book.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace address_manager {
+namespace {
+    uint64_t mix(uint64_t x)
+    {
+        // splitmix64 finalizer
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+    uint64_t hash(uint64_t key, uint64_t a, uint64_t b = 0)
+    {
+        return mix(key ^ mix(a ^ mix(b + 0x9e3779b97f4a7c15ull)));
+    }
+    uint64_t group(IPv4 ip)
+    {
+        return ip.data >> 16;
+    }
+    uint64_t to_u64(const EndpointAddress& a)
+    {
+        return (uint64_t(a.ipv4.data) << 16) | a.port;
+    }
+}
+
+size_t AddressBook::Hasher::operator()(const EndpointAddress& a) const
+{
+    return hash(key, to_u64(a));
+}
+
+AddressBook::AddressBook()
+    : key(std::random_device {}() | (uint64_t(std::random_device {}()) << 32))
+    , rng(std::random_device {}())
+    , slots(capacity, npos)
+    , index(capacity, Hasher { key })
+{
+    addresses.reserve(capacity);
+    slotOf.reserve(capacity);
+}
+
+uint32_t AddressBook::slot_of(const EndpointAddress& a, IPv4 source) const
+{
+    const uint64_t srcGroup { group(source) };
+    const uint64_t groupSlot { hash(key, group(a.ipv4), srcGroup) % bucketsPerSourceGroup };
+    const uint64_t bucket { hash(key, srcGroup, groupSlot) % nBuckets };
+    const uint64_t pos { hash(key, bucket, to_u64(a)) % bucketSize };
+    return bucket * bucketSize + pos;
+}
+
+bool AddressBook::insert(const EndpointAddress& a, IPv4 source)
+{
+    if (index.contains(a))
+        return false;
+    const uint32_t slot { slot_of(a, source) };
+    if (slots[slot] != npos)
+        erase_at(slots[slot]);
+    slots[slot] = addresses.size();
+    addresses.push_back(a);
+    slotOf.push_back(slot);
+    index.emplace(a, slot);
+    return true;
+}
+
+void AddressBook::erase(const EndpointAddress& a)
+{
+    auto iter { index.find(a) };
+    if (iter == index.end())
+        return;
+    erase_at(slots[iter->second]);
+}
+
+void AddressBook::erase_at(uint32_t pos)
+{
+    assert(pos < addresses.size());
+    index.erase(addresses[pos]);
+    slots[slotOf[pos]] = npos;
+
+    // swap with last element
+    const uint32_t last = addresses.size() - 1;
+    if (pos != last) {
+        addresses[pos] = addresses[last];
+        slotOf[pos] = slotOf[last];
+        slots[slotOf[pos]] = pos;
+    }
+    addresses.pop_back();
+    slotOf.pop_back();
+}
+
+std::optional<EndpointAddress> AddressBook::pop_random()
+{
+    if (addresses.empty())
+        return {};
+    const uint32_t pos = std::uniform_int_distribution<size_t>(0, addresses.size() - 1)(rng);
+    EndpointAddress a { addresses[pos] };
+    erase_at(pos);
+    return a;
+}
+
+std::vector<EndpointAddress> AddressBook::sample(size_t N) const
+{
+    return sample_distinct(addresses, N, rng);
+}
+
+void AddressBook::clear()
+{
+    std::fill(slots.begin(), slots.end(), npos);
+    addresses.clear();
+    slotOf.clear();
+    index.clear();
+}
+
+void FailedAddresses::insert(const EndpointAddress& a, clock::time_point now)
+{
+    book.insert(a);
+    failedAt.insert_or_assign(a, now);
+    if (failedAt.size() > 2 * AddressBook::capacity)
+        prune();
+}
+
+void FailedAddresses::erase(const EndpointAddress& a)
+{
+    book.erase(a);
+    failedAt.erase(a);
+}
+
+bool FailedAddresses::contains(const EndpointAddress& a, clock::time_point now)
+{
+    if (!book.contains(a))
+        return false;
+    auto iter { failedAt.find(a) };
+    assert(iter != failedAt.end());
+    if (iter->second + expiry > now)
+        return true;
+    book.erase(a);
+    failedAt.erase(iter);
+    return false;
+}
+
+void FailedAddresses::prune()
+{
+    std::erase_if(failedAt, [&](auto& p) { return !book.contains(p.first); });
+}
+}
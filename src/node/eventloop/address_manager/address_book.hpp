@@ -0,0 +1,110 @@
+#pragma once
+#include "general/tcp_util.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace address_manager {
+
+// N distinct uniformly random elements of v, cost only depends on N
+template <typename T, typename Rng>
+std::vector<T> sample_distinct(const std::vector<T>& v, size_t N, Rng& rng)
+{
+    if (N >= v.size())
+        return v;
+    std::vector<T> out;
+    out.reserve(N);
+    if (2 * N > v.size()) { // v is small, linear scan is cheap
+        std::sample(v.begin(), v.end(), std::back_inserter(out), N, rng);
+        return out;
+    }
+    std::vector<size_t> positions;
+    positions.reserve(N);
+    std::uniform_int_distribution<size_t> dist(0, v.size() - 1);
+    while (positions.size() < N) {
+        size_t pos = dist(rng);
+        if (std::find(positions.begin(), positions.end(), pos) == positions.end())
+            positions.push_back(pos);
+    }
+    for (auto pos : positions)
+        out.push_back(v[pos]);
+    return out;
+}
+
+// Bounded set of endpoint addresses organized in buckets. The bucket of an
+// address is determined by its /16 group and by the /16 group of the peer
+// it was learned from, each source group can only reach a limited number of
+// buckets. This way a single source cannot flood the whole table. On slot
+// collision the newer address replaces the older one.
+class AddressBook {
+    static constexpr uint32_t npos = uint32_t(-1);
+
+public:
+    static constexpr size_t nBuckets { 256 };
+    static constexpr size_t bucketSize { 32 };
+    static constexpr size_t bucketsPerSourceGroup { 16 };
+    static constexpr size_t capacity { nBuckets * bucketSize };
+
+    AddressBook();
+    bool contains(const EndpointAddress& a) const { return index.contains(a); }
+    // returns whether the address was not yet contained
+    bool insert(const EndpointAddress& a, IPv4 source);
+    bool insert(const EndpointAddress& a) { return insert(a, a.ipv4); }
+    void erase(const EndpointAddress& a);
+
+    // uniformly random element in O(1)
+    [[nodiscard]] std::optional<EndpointAddress> pop_random();
+    [[nodiscard]] std::vector<EndpointAddress> sample(size_t N) const;
+
+    const std::vector<EndpointAddress>& data() const { return addresses; }
+    size_t size() const { return addresses.size(); }
+    bool empty() const { return addresses.empty(); }
+    void clear();
+
+private:
+    struct Hasher {
+        size_t operator()(const EndpointAddress& a) const;
+        uint64_t key;
+    };
+    uint32_t slot_of(const EndpointAddress&, IPv4 source) const;
+    void erase_at(uint32_t pos);
+
+private:
+    uint64_t key;
+    mutable std::mt19937_64 rng;
+    std::vector<uint32_t> slots; // slot -> position in addresses or npos
+    std::vector<EndpointAddress> addresses; // dense for O(1) sampling
+    std::vector<uint32_t> slotOf; // position in addresses -> slot
+    std::unordered_map<EndpointAddress, uint32_t, Hasher> index; // address -> slot
+};
+
+// Outbound addresses that recently failed to connect. An entry expires
+// after a fixed time such that peers which were down only temporarily are
+// retried. The number of entries is bounded by an AddressBook.
+class FailedAddresses {
+    using clock = std::chrono::steady_clock;
+
+public:
+    FailedAddresses(clock::duration expiry)
+        : expiry(expiry)
+    {
+    }
+    void insert(const EndpointAddress& a, clock::time_point now);
+    void erase(const EndpointAddress& a);
+    // returns whether a failed within the expiry time, erases expired entries
+    [[nodiscard]] bool contains(const EndpointAddress& a, clock::time_point now);
+    size_t size() const { return book.size(); }
+
+private:
+    void prune();
+
+    clock::duration expiry;
+    AddressBook book;
+    std::map<EndpointAddress, clock::time_point> failedAt; // may contain entries evicted from book
+};
+}
@@ -116,20 +116,7 @@ std::optional<std::chrono::steady_clock::time_point> AddressManager::wakeup_time
 
 std::vector<EndpointAddress> AddressManager::sample_verified(size_t N)
 {
-    // update cache if necessary
-    if (!cacheExpire || *cacheExpire <= sc::now()) {
-        cacheExpire = sc::now() + 1min;
-        verifiedCache.clear();
-        for (auto& [a, _] : verified) {
-            verifiedCache.push_back(a);
-        }
-    }
-
-    // sample from cache
-    std::vector<EndpointAddress> out;
-    std::sample(verifiedCache.begin(), verifiedCache.end(), std::back_inserter(out),
-        N, std::mt19937 { std::random_device {}() });
-    return out;
+    return sample_distinct(verifiedSample, N, rng);
 }
 
 bool AddressManager::pin(EndpointAddress a)
@@ -185,6 +172,7 @@ namespace {
 AddressManager::AddressManager(PeerServer& peerServer, const std::vector<EndpointAddress>& as)
     : peerServer(peerServer)
     , ownIps(interface_ips_v4())
+    , failedAddresses(failedSleep)
 {
     // get recently seen peers from db
     std::promise<std::vector<std::pair<EndpointAddress, uint32_t>>> p;
@@ -196,7 +184,7 @@ AddressManager::AddressManager(PeerServer& peerServer, const std::vector<Endpoin
     auto db_peers = future.get();
     int64_t nowts = now_timestamp();
     for (const auto& [a, timestamp] : db_peers) {
-        auto p = verified.try_emplace(a, timer.end());
+        auto p = insert_verified(a);
         assert(p.second);
         set_timer(sc::now(), p.first);
         auto& node = p.first->second;
@@ -214,10 +202,7 @@ bool AddressManager::on_failed_outbound(EndpointAddress a)
         return false;
 
     // failed addresses bookkeeping
-    failedAddresses.insert(a);
-    if (failedAddresses.size() > 1000) {
-        failedAddresses.clear();
-    }
+    failedAddresses.insert(a, sc::now());
 
     // verified addresses bookkeeping
     if (auto iter = verified.find(a); iter != verified.end()) {
@@ -261,13 +246,11 @@ std::vector<EndpointAddress> AddressManager::pop_connect()
                 out.push_back(a);
                 pendingOutgoing.try_emplace(a, now);
             }
-        } else if (unverifiedAddresses.size() > 0) {
-            auto& a = *unverifiedAddresses.begin();
-            if (!failedAddresses.contains(a) && !verified.contains(a)) {
-                if (pendingOutgoing.emplace(a, now).second)
-                    out.push_back(a);
+        } else if (auto a { unverifiedAddresses.pop_random() }) {
+            if (!failedAddresses.contains(*a, now) && !verified.contains(*a)) {
+                if (pendingOutgoing.emplace(*a, now).second)
+                    out.push_back(*a);
             }
-            unverifiedAddresses.erase(unverifiedAddresses.begin());
         } else
             break;
     }
@@ -280,28 +263,28 @@ bool AddressManager::is_own_endpoint(EndpointAddress a)
         && config().node.bind.port == a.port);
 }
 
-void AddressManager::insert_unverified(EndpointAddress a)
+void AddressManager::insert_unverified(EndpointAddress a, IPv4 source)
 {
     if (pendingOutgoing.contains(a)
         || verified.contains(a)
-        || failedAddresses.contains(a)
+        || failedAddresses.contains(a, sc::now())
         || is_own_endpoint(a)
         || !a.ipv4.is_valid(config().peers.allowLocalhostIp))
         return;
 
-    unverifiedAddresses.insert(a);
+    unverifiedAddresses.insert(a, source);
 }
 
 void AddressManager::queue_verification(EndpointAddress a)
 {
-    insert_unverified(a);
+    insert_unverified(a, a.ipv4);
 }
 
-void AddressManager::queue_verification(const std::vector<EndpointAddress>& as)
+void AddressManager::queue_verification(const std::vector<EndpointAddress>& as, IPv4 source)
 {
     spdlog::debug("Queueing {} unverified addresses. BEFORE: {}", as.size(), unverifiedAddresses.size());
     for (auto& a : as) {
-        insert_unverified(a);
+        insert_unverified(a, source);
     }
 }
 
@@ -313,7 +296,7 @@ void AddressManager::just_verified(EndpointAddress a, bool setTimer)
     spdlog::debug("DB seen peer {}", a.to_string());
 
     auto now = sc::now();
-    auto p = verified.try_emplace(a, timer.end());
+    auto p = insert_verified(a);
     if (setTimer) {
         set_timer(now + successSleep, p.first);
     }
@@ -322,6 +305,28 @@ void AddressManager::just_verified(EndpointAddress a, bool setTimer)
         check_prune_verified();
 }
 
+auto AddressManager::insert_verified(EndpointAddress a) -> std::pair<VerIter, bool>
+{
+    auto p = verified.try_emplace(a, timer.end());
+    if (p.second) {
+        p.first->second.samplePos = verifiedSample.size();
+        verifiedSample.push_back(a);
+    }
+    return p;
+}
+
+void AddressManager::erase_verified(VerIter iter)
+{
+    // swap with last element
+    const size_t pos { iter->second.samplePos };
+    if (pos + 1 != verifiedSample.size()) {
+        verifiedSample[pos] = verifiedSample.back();
+        verified.find(verifiedSample[pos])->second.samplePos = pos;
+    }
+    verifiedSample.pop_back();
+    verified.erase(iter);
+}
+
 void AddressManager::check_prune_verified()
 {
     // prune by connected and lastVerified
@@ -339,7 +344,7 @@ void AddressManager::check_prune_verified()
         const size_t N = verified.size() - verifiedPruneTo;
         for (size_t i = 0; i < N; ++i) {
             remove_timer(v[i]);
-            verified.erase(v[i]);
+            erase_verified(v[i]);
         }
     }
 }
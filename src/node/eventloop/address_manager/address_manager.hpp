@@ -1,6 +1,6 @@
 #pragma once
 #include "../types/conndata.hpp"
-#include "flat_address_set.hpp"
+#include "address_book.hpp"
 #include "general/tcp_util.hpp"
 #include <chrono>
 #include <map>
@@ -41,6 +41,7 @@ private:
         TimerType::iterator timer_iter;
         std::chrono::steady_clock::time_point lastVerified;
         bool outboundConnection = false;
+        size_t samplePos = 0; // position in verifiedSample
     };
     struct PinState {
         PinState()
@@ -166,7 +167,7 @@ public:
 
     // access queued
     std::vector<EndpointAddress> pop_connect();
-    void queue_verification(const std::vector<EndpointAddress>&);
+    void queue_verification(const std::vector<EndpointAddress>&, IPv4 source);
 
     // pin control
     std::optional<std::chrono::steady_clock::time_point> wakeup_time();
@@ -179,12 +180,14 @@ public:
 
 private:
     void queue_verification(EndpointAddress);
+    std::pair<VerIter, bool> insert_verified(EndpointAddress);
+    void erase_verified(VerIter);
     void check_prune_verified();
     void just_verified(EndpointAddress, bool setTimer);
     void remove_timer(VerIter);
     void set_timer(sc::time_point, VerIter);
     void remove_timer(PinIter);
-    void insert_unverified(EndpointAddress a);
+    void insert_unverified(EndpointAddress a, IPv4 source);
     bool is_own_endpoint(EndpointAddress a);
 
 private:
@@ -196,16 +199,16 @@ private:
     size_t verifiedPruneTo = 100;
     const std::vector<IPv4> ownIps;
 
-    FlatAddressSet failedAddresses;
+    FailedAddresses failedAddresses;
+    AddressBook unverifiedAddresses;
 
     // maps/sets by EndpointAddress
-    std::set<EndpointAddress> unverifiedAddresses;
     VerifiedMap verified;
     PinnedMap pinned;
 
-    // verifiedCache as vector for fast sampling
-    std::vector<EndpointAddress> verifiedCache;
-    std::optional<sc::time_point> cacheExpire;
+    // verified addresses as vector for fast sampling
+    std::vector<EndpointAddress> verifiedSample;
+    std::mt19937_64 rng { std::random_device {}() };
 
     // Timer
     TimerType timer;
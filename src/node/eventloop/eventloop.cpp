@@ -6,6 +6,7 @@
 #include "block/header/batch.hpp"
 #include "block/header/view.hpp"
 #include "chainserver/server.hpp"
+#include "general/threads.hpp"
 #include "global/globals.hpp"
 #include "mempool/order_key.hpp"
 #include "peerserver/peerserver.hpp"
@@ -18,6 +19,19 @@
 #include <sstream>
 
 using namespace std::chrono_literals;
+
+struct Eventloop::UVHandles {
+    uv_async_t wakeup;
+    uv_timer_t timer;
+    uv_idle_t idle; // runs events deferred on the loop thread
+    std::queue<Event> local; // deferred on the loop thread, no locking
+};
+
+namespace {
+// eventloop running on this thread's libuv loop in single-thread mode
+thread_local const Eventloop* uvLoopEventloop { nullptr };
+}
+
 Eventloop::Eventloop(PeerServer& ps, ChainServer& cs, const Config& config)
     : stateServer(cs)
     , chains(cs.get_chainstate())
@@ -52,14 +66,93 @@ void Eventloop::start_async_loop()
     }
 }
 
+void Eventloop::start_uv_loop(uv_loop_t* l)
+{
+    // In single-thread mode the eventloop handlers run as libuv callbacks
+    // on the networking thread and timers are driven by a uv_timer.
+    auto h { std::make_unique<UVHandles>() };
+    h->wakeup.data = h->timer.data = h->idle.data = this;
+    if (uv_async_init(l, &h->wakeup, [](uv_async_t* handle) {
+            reinterpret_cast<Eventloop*>(handle->data)->uv_work();
+        }) != 0
+        || uv_timer_init(l, &h->timer) != 0
+        || uv_idle_init(l, &h->idle) != 0)
+        throw std::runtime_error("Cannot initialize eventloop libuv handles");
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        uvHandles = std::move(h);
+    }
+    uvLoopEventloop = this;
+    connect_scheduled();
+    uv_async_send(&uvHandles->wakeup); // process events deferred so far
+}
+
+void Eventloop::uv_work()
+{
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        haswork = false;
+    }
+    work();
+    if (check_shutdown()) {
+        uvLoopEventloop = nullptr; // further events are refused by defer()
+        {
+            std::unique_lock<std::mutex> l(mutex);
+            uvClosed = true; // no uv_async_send from other threads anymore
+        }
+        uv_close(reinterpret_cast<uv_handle_t*>(&uvHandles->wakeup), nullptr);
+        uv_close(reinterpret_cast<uv_handle_t*>(&uvHandles->timer), nullptr);
+        uv_close(reinterpret_cast<uv_handle_t*>(&uvHandles->idle), nullptr);
+        return;
+    }
+    update_uv_timer();
+}
+
+bool Eventloop::defer_local(Event&& e)
+{
+    // Caller is on the loop thread: no lock and no wakeup, the idle handle
+    // processes the batch in the next loop iteration without blocking poll.
+    auto& h { *uvHandles };
+    if (h.local.empty())
+        uv_idle_start(&h.idle, [](uv_idle_t* handle) {
+            uv_idle_stop(handle);
+            reinterpret_cast<Eventloop*>(handle->data)->uv_work();
+        });
+    h.local.push(std::move(e));
+    return true;
+}
+
+void Eventloop::update_uv_timer()
+{
+    using namespace std::chrono;
+    auto ms { duration_cast<milliseconds>(timer.next() - steady_clock::now()).count() + 1 };
+    uv_timer_start(
+        &uvHandles->timer, [](uv_timer_t* handle) {
+            reinterpret_cast<Eventloop*>(handle->data)->uv_work();
+        },
+        std::max(ms, decltype(ms)(0)), 0);
+}
+
+void Eventloop::notify()
+{
+    // mutex must be locked
+    if (uvHandles) {
+        if (!uvClosed)
+            uv_async_send(&uvHandles->wakeup);
+    } else
+        cv.notify_one();
+}
+
 bool Eventloop::defer(Event e)
 {
+    if (uvLoopEventloop == this)
+        return defer_local(std::move(e));
     std::unique_lock<std::mutex> l(mutex);
     if (closeReason)
         return false;
     haswork = true;
     events.push(std::move(e));
-    cv.notify_one();
+    notify();
     return true;
 }
 bool Eventloop::async_process(std::shared_ptr<Connection> c)
@@ -71,7 +164,7 @@ void Eventloop::async_shutdown(int32_t reason)
     std::unique_lock<std::mutex> l(mutex);
     haswork = true;
     closeReason = reason;
-    cv.notify_one();
+    notify();
 }
 
 void Eventloop::async_report_failed_outbound(EndpointAddress a)
@@ -109,6 +202,21 @@ void Eventloop::api_inspect(InspectorCb&& cb)
 {
     defer(std::move(cb));
 }
+void Eventloop::api_get_mempool(MempoolCb&& cb)
+{
+    defer(GetMempool { std::move(cb) });
+}
+
+void Eventloop::api_get_mempool_page(mempool::PageOrder order, std::optional<mempool::PageCursor> after, MempoolPageCb&& cb)
+{
+    defer(GetMempoolPage { order, after, std::move(cb) });
+}
+
+void Eventloop::api_get_fee_histogram(FeeHistogramCb&& cb)
+{
+    defer(GetFeeHistogram { std::move(cb) });
+}
+
 void Eventloop::api_get_hashrate(HashrateCb&& cb, size_t n)
 {
     defer(GetHashrate { std::move(cb), n });
@@ -124,6 +232,11 @@ void Eventloop::async_forward_blockrep(uint64_t conId, std::vector<BodyContainer
     defer(OnForwardBlockrep { conId, std::move(blocks) });
 }
 
+void Eventloop::async_forward_prefetched(uint64_t conId, DescriptedBlockRange range, std::vector<BodyContainer>&& blocks)
+{
+    defer(OnPrefetchedBlocks { conId, range, std::move(blocks) });
+}
+
 bool Eventloop::has_work()
 {
     auto now = std::chrono::steady_clock::now();
@@ -132,6 +245,7 @@ bool Eventloop::has_work()
 
 void Eventloop::loop()
 {
+    setup_thread(ThreadRole::Eventloop);
     connect_scheduled();
     while (true) {
         {
@@ -168,12 +282,23 @@ void Eventloop::work()
         },
             data);
     }
-    while (!tmp.empty()) {
-        std::visit([&](auto&& e) {
-            handle_event(std::move(e));
-        },
-            tmp.front());
-        tmp.pop();
+    auto process = [&](decltype(events)& q) {
+        while (!q.empty()) {
+            std::visit([&](auto&& e) {
+                handle_event(std::move(e));
+            },
+                q.front());
+            q.pop();
+        }
+    };
+    process(tmp);
+    if (uvLoopEventloop == this) {
+        // events deferred on the loop thread, also by the handlers above
+        while (!uvHandles->local.empty()) {
+            std::swap(tmp, uvHandles->local);
+            process(tmp);
+        }
+        uv_idle_stop(&uvHandles->idle);
     }
     connections.garbage_collect();
     update_sync_state();
@@ -195,7 +320,10 @@ bool Eventloop::check_shutdown()
         erase(cr, closeReason);
     }
 
-    stateServer.shutdown_join();
+    // in single-thread mode we are on the libuv thread which must not
+    // block, main joins the chain server after uv_run returned
+    if (!uvHandles)
+        stateServer.shutdown_join();
     return true;
 }
 
@@ -227,6 +355,7 @@ void Eventloop::handle_event(StateUpdate&& e)
 void Eventloop::update_chain(Append&& m)
 {
     const auto msg = chains.update_consensus(std::move(m));
+    const SharedSndbuffer buf { Sndbuffer(msg) }; // serialize once for all peers
     log_chain_length();
     for (auto c : connections.all()) {
         try {
@@ -235,7 +364,7 @@ void Eventloop::update_chain(Append&& m)
         } catch (ChainError e) {
             close(c, e);
         }
-        c.send(msg);
+        c.send(buf);
     }
     //  broadcast new snapshot
     for (auto c : connections.initialized())
@@ -248,12 +377,13 @@ void Eventloop::update_chain(Append&& m)
 void Eventloop::update_chain(Fork&& fork)
 {
     const auto msg { chains.update_consensus(std::move(fork)) };
+    const SharedSndbuffer buf { Sndbuffer(msg) }; // serialize once for all peers
     log_chain_length();
     for (auto c : connections.all()) {
         try {
             if (c.initialized())
                 c->chain.on_consensus_fork(msg.forkHeight, chains);
-            c.send(msg);
+            c.send(buf);
         } catch (ChainError e) {
             close(c, e);
         }
@@ -268,11 +398,12 @@ void Eventloop::update_chain(RollbackData&& rd)
     // update consensus
     const auto msg { chains.update_consensus(rd) };
     if (msg) {
+        const SharedSndbuffer buf { Sndbuffer(*msg) };
         log_chain_length();
         for (auto c : connections.all()) {
             if (c.initialized())
                 c->chain.on_consensus_shrink(chains);
-            c.send(*msg);
+            c.send(buf);
         }
     }
     headerDownload.on_signed_snapshot_update();
@@ -376,6 +507,25 @@ void Eventloop::handle_event(OnForwardBlockrep&& m)
     }
 }
 
+void Eventloop::handle_event(OnPrefetchedBlocks&& m)
+{
+    using namespace std::placeholders;
+    auto cr { connections.find(m.conId) };
+    if (!cr)
+        return;
+    auto reply { cr->blockReadAhead.on_prefetched(m.range, std::move(m.blocks), readAheadBudget) };
+    if (!reply)
+        return;
+    if (reply->blocks.empty()) {
+        // chain changed meanwhile, serve request the ordinary way
+        stateServer.async_get_blocks(m.range, std::bind(&Eventloop::async_forward_blockrep, this, cr.id(), _1));
+        return;
+    }
+    BlockrepMsg msg(reply->nonce, std::move(reply->blocks));
+    cr.send(msg);
+    prefetch_blocks(cr, reply->next);
+}
+
 void Eventloop::handle_event(OnFailedAddressEvent&& e)
 {
     if (connections.on_failed_outbound(e.a))
@@ -400,6 +550,46 @@ void Eventloop::handle_event(GetHashrateChart&& e)
     e.cb(consensus().headers().hashrate_chart(e.from, e.to, e.window));
 }
 
+void Eventloop::handle_event(GetMempool&& e)
+{
+    std::vector<Hash> hashes;
+    const NonzeroHeight nextHeight { (consensus().headers().length() + 1).nonzero_assert() };
+    auto entries = mempool.get_payments(2000, nextHeight, &hashes);
+    API::MempoolEntries out;
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        out.entries.push_back(API::MempoolEntry {
+            entries[i], hashes[i] });
+    }
+    e.cb(out);
+}
+
+void Eventloop::handle_event(GetMempoolPage&& e)
+{
+    constexpr size_t pageSize { 200 };
+    try {
+        auto page { mempool.get_page(e.order, e.after, pageSize) };
+        API::MempoolPage out {
+            .entries {},
+            .next { page.next },
+            .total = mempool.size()
+        };
+        out.entries.reserve(page.entries.size());
+        for (auto& [txid, v] : page.entries)
+            out.entries.push_back({ { txid, v }, v.hash, v.timestamp });
+        e.cb(out);
+    } catch (const Error& err) {
+        e.cb(tl::make_unexpected(err.e));
+    }
+}
+
+void Eventloop::handle_event(GetFeeHistogram&& e)
+{
+    e.cb(API::MempoolFeeHistogram {
+        .counts { mempool.fee_histogram() },
+        .total = mempool.size(),
+        .minFee { mempool.min_fee() } });
+}
+
 void Eventloop::handle_event(OnPinAddress&& e)
 {
     connections.pin(e.a);
@@ -419,6 +609,7 @@ void Eventloop::handle_event(mempool::Log&& log)
     for (auto& action : log) {
         if (std::holds_alternative<mempool::Put>(action)) {
             entries.push_back(std::get<mempool::Put>(action).entry);
+            txRequests.received(entries.back().first);
         }
     }
     std::sort(entries.begin(), entries.end(),
@@ -448,9 +639,13 @@ void Eventloop::handle_event(mempool::Log&& log)
         }
     finished:
 
-        // send subscription individually
+        // send subscription individually, subscribers with equal
+        // bounds share one serialized message
+        std::optional<std::pair<decltype(entries)::iterator, SharedSndbuffer>> last;
         for (auto& [end, cr] : bounds) {
-            cr.send(TxnotifyMsg::direct_send(entries.begin(), end));
+            if (!last || last->first != end)
+                last.emplace(end, TxnotifyMsg::direct_send(entries.begin(), end));
+            cr.send(last->second);
         }
     }
 }
@@ -474,6 +669,8 @@ void Eventloop::erase(Conref c, int32_t error)
     }
     if (blockDownload.erase(c))
         coordinate_sync();
+    txRequests.erase_connection(c.id());
+    update_txrequests_wakeup();
     if (connections.erase(c.iterator()))
         update_wakeup();
     if (doRequests) {
@@ -550,7 +747,7 @@ void Eventloop::process_connection(std::shared_ptr<Connection> c)
     Conref cr { c->dataiter };
     for (auto& msg : messages) {
         try {
-            dispatch_message(cr, msg);
+            dispatch_message(cr, std::move(msg));
             // active
         } catch (Error e) {
             close(cr, e.e);
@@ -596,6 +793,20 @@ void Eventloop::update_wakeup()
     wakeupTimer = timer.insert(*wakeupTime, Timer::Connect {});
 }
 
+void Eventloop::update_txrequests_wakeup()
+{
+    auto expiry { txRequests.next_expiry() };
+    if (txRequestsTimer && (expiry == (*txRequestsTimer)->first))
+        return; // no change
+    if (txRequestsTimer) {
+        timer.cancel(*txRequestsTimer);
+        txRequestsTimer.reset();
+    }
+    if (!expiry)
+        return;
+    txRequestsTimer = timer.insert(*expiry, Timer::TxRequestsExpire {});
+}
+
 void Eventloop::send_requests(Conref cr, const std::vector<Request>& requests)
 {
     for (auto& r : requests) {
@@ -712,13 +923,26 @@ void Eventloop::handle_timeout(Timer::Connect&&)
     update_wakeup();
 }
 
-void Eventloop::dispatch_message(Conref cr, Rcvbuffer& msg)
+void Eventloop::handle_timeout(Timer::TxRequestsExpire&&)
 {
-    using namespace messages;
-    if (msg.verify() == false)
-        throw Error(ECHECKSUM);
+    txRequestsTimer.reset();
+    for (auto& [conId, txids] : txRequests.pop_expired()) {
+        if (auto cr { connections.find(conId) }; cr)
+            send_txreqs(cr, txids);
+    }
+    update_txrequests_wakeup();
+}
 
-    auto m = msg.parse();
+void Eventloop::handle_timeout(Timer::StageFlush&&)
+{
+    stageTimer.reset();
+    process_blockdownload_stage();
+}
+
+void Eventloop::dispatch_message(Conref cr, messages::Msg&& m)
+{
+    using namespace messages;
+    // checksum and structure were verified on the networking thread
     // first message must be of type INIT (is_init() is only initially true)
     if (cr.job().awaiting_init()) {
         if (!std::holds_alternative<InitMsg>(m)) {
@@ -799,7 +1023,7 @@ void Eventloop::handle_msg(Conref cr, PongMsg&& m)
     auto& pingMsg = cr.ping().check(m);
     received_pong_sleep_ping(cr);
     spdlog::debug("{} Received {} addresses", cr.str(), m.addresses.size());
-    connections.queue_verification(m.addresses);
+    connections.queue_verification(m.addresses, cr->c->peer_endpoint().ipv4);
     spdlog::debug("{} Got {} transaction Ids in pong message", cr.str(), m.txids.size());
 
     // update acknowledged priority
@@ -808,9 +1032,7 @@ void Eventloop::handle_msg(Conref cr, PongMsg&& m)
     }
 
     // request new txids
-    auto txids = mempool.filter_new(m.txids);
-    if (txids.size() > 0)
-        cr.send(TxreqMsg(txids));
+    request_new_txs(cr, m.txids);
 
     // connect scheduled (in case new addresses were added)
     connect_scheduled();
@@ -899,7 +1121,26 @@ void Eventloop::handle_msg(Conref cr, BlockreqMsg&& m)
     if (config().node.logCommunication)
         spdlog::info("{} handle_blockreq [{},{}]", cr.str(), req.range.lower.value(), req.range.upper.value());
     cr->lastNonce = req.nonce;
-    stateServer.async_get_blocks(req.range, std::bind(&Eventloop::async_forward_blockrep, this, cr.id(), _1));
+    auto& ra { cr->blockReadAhead };
+    if (auto blocks { ra.take(req.range) }) {
+        BlockrepMsg msg(req.nonce, std::move(*blocks));
+        cr.send(msg);
+    } else if (ra.reply_on_arrival(req.range, req.nonce)) {
+        // the peer waits for it now, prefetches are only served when idle
+        stateServer.promote_prefetch(req.range);
+    } else
+        stateServer.async_get_blocks(req.range, std::bind(&Eventloop::async_forward_blockrep, this, cr.id(), _1));
+    prefetch_blocks(cr, ra.on_request(req.range));
+}
+
+void Eventloop::prefetch_blocks(Conref cr, const std::optional<DescriptedBlockRange>& r)
+{
+    using namespace std::placeholders;
+    if (!r || r->descriptor != consensus().descriptor()
+        || r->upper > consensus().headers().length())
+        return;
+    if (stateServer.async_prefetch_blocks(*r, std::bind(&Eventloop::async_forward_prefetched, this, cr.id(), *r, _1)))
+        cr->blockReadAhead.set_pending(*r);
 }
 
 void Eventloop::handle_msg(Conref cr, BlockrepMsg&& m)
@@ -921,9 +1162,7 @@ void Eventloop::handle_msg(Conref cr, TxnotifyMsg&& m)
 {
     if (config().node.logCommunication)
         spdlog::info("{} handle Txnotify", cr.str());
-    auto txids = mempool.filter_new(m.txids);
-    if (txids.size() > 0)
-        cr.send(TxreqMsg(txids));
+    request_new_txs(cr, m.txids);
     do_requests();
 }
 
@@ -945,10 +1184,13 @@ void Eventloop::handle_msg(Conref cr, TxrepMsg&& m)
         spdlog::info("{} handle TxrepMsg", cr.str());
     std::vector<TransferTxExchangeMessage> txs;
     for (auto& o : m.txs) {
-        if (o)
+        // skip transactions we already received from another peer
+        if (o && txRequests.received(o->txid))
             txs.push_back(*o);
     };
-    stateServer.async_put_mempool(std::move(txs));
+    if (txs.size() > 0)
+        stateServer.async_put_mempool(std::move(txs));
+    update_txrequests_wakeup();
     do_requests();
 }
 
@@ -971,6 +1213,22 @@ void Eventloop::handle_msg(Conref cr, LeaderMsg&& msg)
     stateServer.async_set_signed_checkpoint(msg.signedSnapshot);
 }
 
+void Eventloop::request_new_txs(Conref cr, const std::vector<TxidWithFee>& announced)
+{
+    // do not request transactions already in flight from other peers
+    auto txids { txRequests.announce(cr.id(), mempool.filter_new(announced)) };
+    send_txreqs(cr, txids);
+    update_txrequests_wakeup();
+}
+
+void Eventloop::send_txreqs(Conref cr, const std::vector<TransactionId>& txids)
+{
+    for (size_t i = 0; i < txids.size(); i += TxreqMsg::MAXENTRIES) {
+        auto end { txids.begin() + std::min(txids.size(), i + TxreqMsg::MAXENTRIES) };
+        cr.send(TxreqMsg(std::vector<TransactionId>(txids.begin() + i, end)));
+    }
+}
+
 void Eventloop::consider_send_snapshot(Conref c)
 {
     // spdlog::info("
@@ -987,8 +1245,13 @@ void Eventloop::consider_send_snapshot(Conref c)
 void Eventloop::process_blockdownload_stage()
 {
     auto r { blockDownload.pop_stage() };
-    if (r)
+    if (r) {
         stateServer.async_stage_request(*r);
+        return;
+    }
+    // stage held back blocks at latest at the deadline
+    if (auto d { blockDownload.stage_deadline() }; d && !stageTimer)
+        stageTimer = timer.insert(*d, Timer::StageFlush {});
 }
 
 void Eventloop::async_stage_action(stage_operation::Result r)
@@ -7,6 +7,7 @@
 #include "chainserver/state/update/update.hpp"
 #include "communication/stage_operation/result.hpp"
 #include "eventloop/timer.hpp"
+#include "eventloop/tx_requests.hpp"
 #include "mempool/mempool.hpp"
 #include "mempool/subscription_declaration.hpp"
 #include "peerserver/peerserver.hpp"
@@ -25,7 +26,6 @@
 #include <algorithm>
 
 class Connection;
-class Rcvbuffer;
 class Reader;
 class Eventprocessor;
 class EndAttorney;
@@ -72,14 +72,21 @@ public:
     void api_get_hashrate_chart(HashrateChartCb&& cb);
     void api_get_hashrate_chart(NonzeroHeight from, NonzeroHeight to, size_t window, HashrateChartCb&& cb);
     void api_inspect(InspectorCb&&);
+    void api_get_mempool(MempoolCb&& cb);
+    void api_get_mempool_page(mempool::PageOrder, std::optional<mempool::PageCursor> after, MempoolPageCb&& cb);
+    void api_get_fee_histogram(FeeHistogramCb&& cb);
 
     void start_async_loop();
+    void start_uv_loop(uv_loop_t*); // single-thread mode
 
 private:
     std::vector<EndpointAddress> get_db_peers(size_t num);
     //////////////////////////////
     // Important event loop functions
     void loop();
+    void uv_work();
+    void update_uv_timer();
+    void notify();
     bool has_work();
     void work();
     bool check_shutdown();
@@ -89,6 +96,7 @@ private:
     // Private async functions
 
     void async_forward_blockrep(uint64_t conId, std::vector<BodyContainer>&& blocks);
+    void async_forward_prefetched(uint64_t conId, DescriptedBlockRange range, std::vector<BodyContainer>&& blocks);
 
     //////////////////////////////
     // Connection related functions
@@ -102,7 +110,7 @@ private:
 
     ////////////////////////
     // Handling incoming messages
-    void dispatch_message(Conref cr, Rcvbuffer& rb);
+    void dispatch_message(Conref cr, messages::Msg&& m);
     void handle_msg(Conref cr, PingMsg&&);
     void handle_msg(Conref cr, PongMsg&&);
     void handle_msg(Conref cr, BatchreqMsg&&);
@@ -123,6 +131,9 @@ private:
     ////////////////////////
     // convenience functions
     void consider_send_snapshot(Conref);
+    void request_new_txs(Conref, const std::vector<TxidWithFee>&);
+    void send_txreqs(Conref, const std::vector<TransactionId>&);
+    void prefetch_blocks(Conref, const std::optional<DescriptedBlockRange>&);
 
     ////////////////////////
     // assign work to connections
@@ -150,6 +161,7 @@ private:
     void send_ping_await_pong(Conref cr);
     void received_pong_sleep_ping(Conref cr);
     void update_wakeup();
+    void update_txrequests_wakeup();
 
     ////////////////////////
     // Timeout callbacks
@@ -157,6 +169,8 @@ private:
     requires std::derived_from<T, Timer::WithConnecitonId>
     void handle_timeout(T&&);
     void handle_timeout(Timer::Connect&&);
+    void handle_timeout(Timer::TxRequestsExpire&&);
+    void handle_timeout(Timer::StageFlush&&);
     void handle_connection_timeout(Conref, Timer::SendPing&&);
     void handle_connection_timeout(Conref, Timer::Expire&&);
     void handle_connection_timeout(Conref, Timer::CloseNoReply&&);
@@ -186,6 +200,11 @@ private:
         uint64_t conId;
         std::vector<BodyContainer> blocks;
     };
+    struct OnPrefetchedBlocks {
+        uint64_t conId;
+        DescriptedBlockRange range;
+        std::vector<BodyContainer> blocks;
+    };
     struct OnFailedAddressEvent {
         EndpointAddress a;
     };
@@ -205,16 +224,28 @@ private:
         HashrateCb cb;
         size_t n;
     };
+    struct GetMempool {
+        MempoolCb cb;
+    };
+    struct GetMempoolPage {
+        mempool::PageOrder order;
+        std::optional<mempool::PageCursor> after;
+        MempoolPageCb cb;
+    };
+    struct GetFeeHistogram {
+        FeeHistogramCb cb;
+    };
     // event queue
     using Event = std::variant<OnRelease, OnProcessConnection,
         StateUpdate, SignedSnapshotCb, PeersCb, SyncedCb, stage_operation::Result,
-        OnForwardBlockrep, OnFailedAddressEvent, InspectorCb, GetHashrate, GetHashrateChart,
-        OnPinAddress, OnUnpinAddress, mempool::Log>;
+        OnForwardBlockrep, OnPrefetchedBlocks, OnFailedAddressEvent, InspectorCb, GetHashrate, GetHashrateChart,
+        OnPinAddress, OnUnpinAddress, mempool::Log, GetMempool, GetMempoolPage, GetFeeHistogram>;
 
 public:
     bool defer(Event e);
 
 private:
+    bool defer_local(Event&& e); // single-thread mode, on the loop thread
     // event handlers
     void handle_event(OnRelease&&);
     void handle_event(OnProcessConnection&&);
@@ -224,6 +255,7 @@ private:
     void handle_event(SignedSnapshotCb&&);
     void handle_event(stage_operation::Result&&);
     void handle_event(OnForwardBlockrep&&);
+    void handle_event(OnPrefetchedBlocks&&);
     void handle_event(OnFailedAddressEvent&&);
     void handle_event(InspectorCb&&);
     void handle_event(GetHashrate&&);
@@ -231,6 +263,9 @@ private:
     void handle_event(OnPinAddress&&);
     void handle_event(OnUnpinAddress&&);
     void handle_event(mempool::Log&&);
+    void handle_event(GetMempool&&);
+    void handle_event(GetMempoolPage&&);
+    void handle_event(GetFeeHistogram&&);
 
     // chain updates
     using Append = chainserver::state_update::Append;
@@ -265,11 +300,15 @@ private: // private data
     // Conndatamap connections;
     StageAndConsensus chains;
     mempool::Mempool mempool; // copy of chainserver mempool
+    TxRequests txRequests;
+    ReadAheadBudget readAheadBudget;
 
     address_manager::AddressManager connections;
 
     Timer timer;
     std::optional<Timer::iterator> wakeupTimer;
+    std::optional<Timer::iterator> txRequestsTimer;
+    std::optional<Timer::iterator> stageTimer;
 
     // Request related
     size_t activeRequests = 0;
@@ -291,6 +330,9 @@ private: // private data
     int32_t closeReason = 0;
     bool blockdownloadHalted = false;
     std::queue<Event> events;
+    struct UVHandles; // set in single-thread mode
+    std::unique_ptr<UVHandles> uvHandles;
+    bool uvClosed = false; // uvHandles closed on shutdown
     std::thread worker; // worker (constructed last)
 };
 
@@ -32,6 +32,7 @@ Downloader::Downloader(Attorney attorney, size_t windowLength)
 std::vector<ChainOffender> Downloader::handle_stage_result(stage_operation::StageAddResult&& a)
 {
     auto offenders { stageState.on_result(a) };
+    commitPolicy.on_result(a.duration);
     if (a.ce)
         reset();
     return offenders;
@@ -55,8 +56,11 @@ ServerCall Downloader::next_stage_call() // OK
         if (stageState.stageSetAck < headers().length())
             return STAGE_SET;
     } else {
-        if (focus.has_data())
-            return STAGE_ADD;
+        if (focus.has_data()) {
+            auto [bytes, canGrow] { focus.available() };
+            if (commitPolicy.ready(bytes, canGrow, std::chrono::steady_clock::now()))
+                return STAGE_ADD;
+        }
     }
     return NO;
 }
@@ -68,7 +72,12 @@ stage_operation::StageAddOperation Downloader::pop_stage_add() // OK
     stageState.pendingOperation.set_stage_add(
         forks.lower_bound(focus.height_begin()),
         forks.end());
-    return { headers(), focus.pop_data() };
+    auto blocks { focus.pop_data(commitPolicy.max_bytes()) };
+    size_t bytes { 0 };
+    for (auto& b : blocks)
+        bytes += b.body.size();
+    commitPolicy.on_stage(bytes);
+    return { headers(), std::move(blocks) };
 }
 
 stage_operation::StageSetOperation Downloader::pop_stage_set() // OK
@@ -330,19 +339,22 @@ void Downloader::on_blockreq_reply(Conref cr, BlockrepMsg&& rep, Blockrequest& r
     if (headers().hash_at(req.range.upper) != req.upperHash)
         return;
 
-    // check merkle roots
+    // check merkle roots, staging relies on this verification
     size_t i0 = (req.range.lower < focus.height_begin() ? focus.height_begin() - req.range.lower : 0);
+    std::vector<VerifiedBody> bodies;
+    bodies.reserve(rep.blocks.size() - i0);
     for (size_t i = i0; i < rep.blocks.size(); ++i) {
         auto height { req.range.lower + i };
-        BodyView bv(rep.blocks[i].view(height));
-        if (!bv.valid())
+        auto vb { VerifiedBody::verify(std::move(rep.blocks[i]), height) };
+        if (!vb)
             throw Error(EINV_BODY);
-        if (bv.merkle_root(height) != headers()[height].merkleroot())
+        if (vb->merkle_root() != headers()[height].merkleroot())
             throw Error(EMROOT);
+        bodies.push_back(std::move(*vb));
     }
 
     const BlockSlot slot(req.range.lower);
-    focus.set_blocks(slot, req.range.lower, std::move(rep.blocks));
+    focus.set_blocks(slot, req.range.lower + i0, std::move(bodies));
     return;
 }
 
@@ -358,6 +370,7 @@ void Downloader::reset()
 
     // download focus related
     focus.clear();
+    commitPolicy.reset();
 
     // state helper variables
     initialized = false;
@@ -8,6 +8,7 @@
 #include "communication/messages.hpp"
 #include "communication/stage_operation/request.hpp"
 #include "communication/stage_operation/result.hpp"
+#include "commit_policy.hpp"
 #include "eventloop/types/conndata.hpp"
 #include "eventloop/types/peer_requests.hpp"
 #include "focus.hpp"
@@ -54,6 +55,7 @@ public:
     //////////////////////////////
     // Getters
     [[nodiscard]] std::optional<stage_operation::Operation> pop_stage();
+    [[nodiscard]] auto stage_deadline() const { return commitPolicy.deadline(); }
     void do_block_requests(RequestSender);
     void do_probe_requests(RequestSender);
     const Worksum& get_reachable_totalwork() const { return reachableWork; }
@@ -90,6 +92,7 @@ private:
 
     // download focus related
     Focus focus;
+    CommitPolicy commitPolicy;
 
     // state helper variables
     bool initialized = false;
@@ -0,0 +1,39 @@
+#include "commit_policy.hpp"
+#include <algorithm>
+
+namespace BlockDownload {
+bool CommitPolicy::ready(size_t availableBytes, bool canGrow, clock::time_point now)
+{
+    if (!canGrow || availableBytes >= minBytes) {
+        heldSince.reset();
+        return true;
+    }
+    if (!heldSince)
+        heldSince = now;
+    return now >= *heldSince + maxDelay;
+}
+
+auto CommitPolicy::deadline() const -> std::optional<clock::time_point>
+{
+    if (!heldSince)
+        return {};
+    return *heldSince + maxDelay;
+}
+
+void CommitPolicy::on_stage(size_t bytes)
+{
+    heldSince.reset();
+    pendingBytes = bytes;
+}
+
+void CommitPolicy::on_result(std::chrono::microseconds duration)
+{
+    // small additions are dominated by fixed commit cost
+    if (pendingBytes < minBytes || duration.count() <= 0)
+        return;
+    const double rate { pendingBytes * 1e6 / duration.count() };
+    bytesPerSecond = bytesPerSecond ? 0.7 * *bytesPerSecond + 0.3 * rate : rate;
+    const double target { *bytesPerSecond * std::chrono::duration<double>(targetDuration).count() };
+    maxBytes = std::clamp(size_t(target), minBytes, maxBytesLimit);
+}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace BlockDownload {
+
+// Sizes the stage additions sent to the chain server. Each stage addition
+// is one database transaction, so its byte size follows the measured apply
+// throughput to keep commit latency near targetDuration. While more blocks
+// are expected, small additions are held back and grouped into one commit.
+class CommitPolicy {
+    using clock = std::chrono::steady_clock;
+
+public:
+    static constexpr std::chrono::milliseconds targetDuration { 500 };
+    static constexpr std::chrono::milliseconds maxDelay { 2000 };
+    static constexpr size_t minBytes { 256 * 1024 }; // group below this size
+    static constexpr size_t maxBytesLimit { 32 * 1024 * 1024 };
+
+    // returns whether available data should be staged now
+    [[nodiscard]] bool ready(size_t availableBytes, bool canGrow, clock::time_point now);
+
+    // returns when held back data must be staged at latest
+    [[nodiscard]] std::optional<clock::time_point> deadline() const;
+    [[nodiscard]] size_t max_bytes() const { return maxBytes; }
+
+    void on_stage(size_t bytes);
+    void on_result(std::chrono::microseconds duration);
+    void reset() { heldSince.reset(); }
+
+private:
+    size_t maxBytes { 4 * 1024 * 1024 };
+    std::optional<double> bytesPerSecond;
+    size_t pendingBytes { 0 };
+    std::optional<clock::time_point> heldSince;
+};
+}
@@ -63,24 +63,31 @@ bool Focus::has_data()
     return false;
 }
 
-std::vector<Block> Focus::pop_data()
+std::vector<VerifiedBlock> Focus::pop_data(size_t maxBytes)
 {
     assert(has_data());
-    std::vector<Block> out;
+    std::vector<VerifiedBlock> out;
+    size_t bytes { 0 };
     for (auto iter = map.begin(); iter != map.end();) {
         Node node { .iter = iter };
         if (!node.covers_next(downloadLength))
             break;
         auto& from = node.blocks();
         out.reserve(out.size() + from.size());
-        for (size_t j = 0; j < from.size(); ++j) {
+        size_t j = 0;
+        for (; j < from.size() && (out.empty() || bytes < maxBytes); ++j) {
             ++downloadLength;
             auto h { downloadLength.nonzero_assert() };
-            out.push_back(Block {
-                .height = h,
+            assert(from[j].height() == h);
+            bytes += from[j].size();
+            out.push_back(VerifiedBlock {
                 .header = headers()[h],
                 .body = std::move(from[j]) });
         }
+        if (j < from.size()) { // byte limit reached
+            from.erase(from.begin(), from.begin() + j);
+            break;
+        }
         if (downloadLength < node.batch_upper()) {
             from.clear();
             break;
@@ -92,6 +99,24 @@ std::vector<Block> Focus::pop_data()
     return out;
 }
 
+auto Focus::available() -> Available
+{
+    size_t bytes { 0 };
+    Height end { downloadLength };
+    for (auto iter = map.begin(); iter != map.end(); ++iter) {
+        Node node { .iter = iter };
+        if (!node.covers_next(end))
+            break;
+        for (auto& b : node.blocks())
+            bytes += b.size();
+        end = end + uint32_t(node.blocks().size());
+        if (end < node.batch_upper())
+            break;
+    }
+    const Height windowEnd { std::min((BlockSlot(height_begin()) + uint32_t(width - 1)).upper_height(), headers().length()) };
+    return { bytes, end < windowEnd };
+}
+
 NonzeroHeight Focus::height_begin()
 {
     return (downloadLength + 1).nonzero_assert();
@@ -209,7 +234,7 @@ void Focus::set_offset(Height newOffset)
     }
 }
 
-void Focus::set_blocks(BlockSlot slot, Height reqBegin, std::vector<BodyContainer>&& blocks)
+void Focus::set_blocks(BlockSlot slot, Height reqBegin, std::vector<VerifiedBody>&& blocks)
 {
     auto [iter, created] { map.try_emplace(slot) };
     FocusNode& fn { iter->second };
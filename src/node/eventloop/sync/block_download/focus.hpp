@@ -1,5 +1,6 @@
 #pragma once
 #include "block/block.hpp"
+#include "block/body/verified.hpp"
 #include "block/chain/header_chain.hpp"
 #include "block/chain/height.hpp"
 #include "eventloop/types/conref_declaration.hpp"
@@ -55,7 +56,7 @@ private:
 };
 
 struct FocusNode {
-    std::vector<BodyContainer> blockBodies;
+    std::vector<VerifiedBody> blockBodies;
     bool activeRequest() { return c.valid(); }
     void register_downloader(Conref);
     Conref conref() const { return c; };
@@ -72,12 +73,17 @@ struct Focus {
 
     NonzeroHeight height_begin();
     void fork(NonzeroHeight);
-    std::vector<Block> pop_data();
+    std::vector<VerifiedBlock> pop_data(size_t maxBytes);
+    struct Available {
+        size_t bytes;
+        bool canGrow; // false if the window is filled up to its end
+    };
+    Available available();
     auto map_end() { return map.end(); }
     void clear(); // precondition: reset all connections focusIter
     void erase(Conref cr);
     void set_offset(Height);
-    void set_blocks(BlockSlot, Height reqBegin, std::vector<BodyContainer>&& blocks);
+    void set_blocks(BlockSlot, Height reqBegin, std::vector<VerifiedBody>&& blocks);
 
     struct FocusSlot {
         FocusMap::iterator iter;
@@ -24,7 +24,11 @@ public:
     };
     struct Connect {
     };
-    using Event = std::variant<SendPing, Expire, CloseNoReply,CloseNoPong, Connect>;
+    struct TxRequestsExpire {
+    };
+    struct StageFlush {
+    };
+    using Event = std::variant<SendPing, Expire, CloseNoReply,CloseNoPong, Connect, TxRequestsExpire, StageFlush>;
 
 private:
     using time_point = std::chrono::steady_clock::time_point;
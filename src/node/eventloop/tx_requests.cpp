@@ -0,0 +1,76 @@
+#include "tx_requests.hpp"
+#include <algorithm>
+
+std::vector<TransactionId> TxRequests::announce(uint64_t conId, const std::vector<TransactionId>& txids, time_point now)
+{
+    std::vector<TransactionId> out;
+    const auto expires { now + timeout };
+    for (auto& txid : txids) {
+        auto iter { entries.find(txid) };
+        if (iter == entries.end()) {
+            if (entries.size() >= maxEntries)
+                continue;
+            entries.emplace(txid, Entry { conId, byExpiry.emplace(expires, txid), {} });
+            out.push_back(txid);
+        } else {
+            auto& e { iter->second };
+            if (e.conId == conId || e.announcers.size() >= maxAnnouncers
+                || std::find(e.announcers.begin(), e.announcers.end(), conId) != e.announcers.end())
+                continue;
+            e.announcers.push_back(conId);
+        }
+    }
+    return out;
+}
+
+bool TxRequests::received(const TransactionId& txid)
+{
+    auto iter { entries.find(txid) };
+    if (iter == entries.end())
+        return false;
+    byExpiry.erase(iter->second.expiry);
+    entries.erase(iter);
+    return true;
+}
+
+void TxRequests::erase_connection(uint64_t conId)
+{
+    const auto now { std::chrono::steady_clock::now() };
+    for (auto& [txid, e] : entries) {
+        std::erase(e.announcers, conId);
+        if (e.conId == conId)
+            set_expiry(e, txid, now); // reassign on next pop_expired()
+    }
+}
+
+auto TxRequests::pop_expired(time_point now) -> Assignments
+{
+    Assignments out;
+    while (!byExpiry.empty() && byExpiry.begin()->first <= now) {
+        auto iter { entries.find(byExpiry.begin()->second) };
+        auto& e { iter->second };
+        if (e.announcers.empty()) {
+            byExpiry.erase(e.expiry);
+            entries.erase(iter);
+            continue;
+        }
+        e.conId = e.announcers.front();
+        e.announcers.erase(e.announcers.begin());
+        set_expiry(e, iter->first, now + timeout);
+        out[e.conId].push_back(iter->first);
+    }
+    return out;
+}
+
+auto TxRequests::next_expiry() const -> std::optional<time_point>
+{
+    if (byExpiry.empty())
+        return {};
+    return byExpiry.begin()->first;
+}
+
+void TxRequests::set_expiry(Entry& e, const TransactionId& txid, time_point tp)
+{
+    byExpiry.erase(e.expiry);
+    e.expiry = byExpiry.emplace(tp, txid);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "block/body/transaction_id.hpp"
+#include <chrono>
+#include <map>
+#include <optional>
+#include <vector>
+
+// Tracks in-flight transaction requests per txid such that a transaction
+// announced by several peers is downloaded only once. If the assigned peer
+// does not deliver in time, the request falls back to another announcer.
+class TxRequests {
+    using time_point = std::chrono::steady_clock::time_point;
+    using ByExpiry = std::multimap<time_point, TransactionId>;
+    struct Entry {
+        uint64_t conId;
+        ByExpiry::iterator expiry;
+        std::vector<uint64_t> announcers; // fallback candidates
+    };
+
+public:
+    using Assignments = std::map<uint64_t, std::vector<TransactionId>>;
+    static constexpr auto timeout { std::chrono::seconds(5) };
+    static constexpr size_t maxEntries { 20000 };
+    static constexpr size_t maxAnnouncers { 8 };
+
+    // returns the txids that shall be requested from conId
+    [[nodiscard]] std::vector<TransactionId> announce(uint64_t conId, const std::vector<TransactionId>&,
+        time_point now = std::chrono::steady_clock::now());
+
+    // returns whether the transaction was requested
+    bool received(const TransactionId&);
+    void erase_connection(uint64_t conId);
+
+    // reassigns expired requests to other announcers
+    [[nodiscard]] Assignments pop_expired(time_point now = std::chrono::steady_clock::now());
+    [[nodiscard]] std::optional<time_point> next_expiry() const;
+    [[nodiscard]] size_t size() const { return entries.size(); }
+
+private:
+    void set_expiry(Entry&, const TransactionId&, time_point);
+
+private:
+    std::map<TransactionId, Entry> entries;
+    ByExpiry byExpiry;
+};
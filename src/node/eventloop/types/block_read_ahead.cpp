@@ -0,0 +1,69 @@
+#include "block_read_ahead.hpp"
+
+namespace {
+bool same_range(const DescriptedBlockRange& r1, const DescriptedBlockRange& r2)
+{
+    return r1.descriptor == r2.descriptor
+        && r1.lower == r2.lower
+        && r1.upper == r2.upper;
+}
+DescriptedBlockRange following(const DescriptedBlockRange& r)
+{
+    return { r.descriptor, r.upper + 1, r.upper + r.length() };
+}
+}
+
+std::optional<std::vector<BodyContainer>> BlockReadAhead::take(const DescriptedBlockRange& r)
+{
+    if (!buffered || !same_range(buffered->range, r))
+        return {};
+    auto blocks { std::move(buffered->blocks) };
+    buffered.reset();
+    return blocks;
+}
+
+bool BlockReadAhead::reply_on_arrival(const DescriptedBlockRange& r, uint32_t nonce)
+{
+    if (!pending || !same_range(*pending, r))
+        return false;
+    pendingNonce = nonce;
+    return true;
+}
+
+std::optional<DescriptedBlockRange> BlockReadAhead::on_request(const DescriptedBlockRange& r)
+{
+    const bool sequential { last
+        && last->descriptor == r.descriptor
+        && last->upper + 1 == r.lower };
+    last = r;
+    if (!sequential) {
+        // peer is not syncing linearly, forget what we prefetched
+        pending.reset();
+        pendingNonce.reset();
+        buffered.reset();
+        return {};
+    }
+    if (pending)
+        return {};
+    return following(r);
+}
+
+auto BlockReadAhead::on_prefetched(const DescriptedBlockRange& r, std::vector<BodyContainer>&& blocks, ReadAheadBudget& budget) -> std::optional<Reply>
+{
+    if (!pending || !same_range(*pending, r))
+        return {};
+    pending.reset();
+    if (pendingNonce) {
+        auto nonce { *pendingNonce };
+        pendingNonce.reset();
+        return Reply { nonce, std::move(blocks), following(r) };
+    }
+    if (blocks.empty()) // beyond chain length
+        return {};
+    size_t bytes { 0 };
+    for (auto& b : blocks)
+        bytes += b.size();
+    if (auto reservation { budget.reserve(bytes) })
+        buffered.emplace(r, std::move(blocks), std::move(*reservation));
+    return {};
+}
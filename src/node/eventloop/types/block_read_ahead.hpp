@@ -0,0 +1,84 @@
+#pragma once
+#include "block/body/container.hpp"
+#include "block/chain/range.hpp"
+#include <optional>
+#include <vector>
+
+// Shared memory budget for the read-ahead buffers of all connections.
+class ReadAheadBudget {
+public:
+    static constexpr size_t maxBytes { 64 * 1024 * 1024 };
+    class Reservation {
+    public:
+        Reservation(ReadAheadBudget& b, size_t bytes)
+            : budget(&b)
+            , bytes(bytes)
+        {
+            budget->used += bytes;
+        }
+        Reservation(Reservation&& other)
+            : budget(other.budget)
+            , bytes(other.bytes)
+        {
+            other.budget = nullptr;
+        }
+        Reservation(const Reservation&) = delete;
+        ~Reservation()
+        {
+            if (budget)
+                budget->used -= bytes;
+        }
+
+    private:
+        ReadAheadBudget* budget;
+        size_t bytes;
+    };
+    std::optional<Reservation> reserve(size_t bytes)
+    {
+        if (used + bytes > maxBytes)
+            return {};
+        return std::optional<Reservation> { std::in_place, *this, bytes };
+    }
+    size_t used_bytes() const { return used; }
+
+private:
+    size_t used { 0 };
+};
+
+// Serve-side read-ahead for a peer that downloads consecutive block ranges
+// from us. After two consecutive requests the following range is prefetched
+// such that the next request can be answered without waiting for the chain
+// server.
+class BlockReadAhead {
+    struct Buffered {
+        DescriptedBlockRange range;
+        std::vector<BodyContainer> blocks;
+        ReadAheadBudget::Reservation reservation;
+    };
+
+public:
+    // returns prefetched blocks matching the request
+    [[nodiscard]] std::optional<std::vector<BodyContainer>> take(const DescriptedBlockRange&);
+
+    // returns whether the request will be answered when the pending
+    // prefetch arrives
+    [[nodiscard]] bool reply_on_arrival(const DescriptedBlockRange&, uint32_t nonce);
+
+    // returns range to prefetch next
+    [[nodiscard]] std::optional<DescriptedBlockRange> on_request(const DescriptedBlockRange&);
+    void set_pending(const DescriptedBlockRange& r) { pending = r; }
+
+    struct Reply {
+        uint32_t nonce;
+        std::vector<BodyContainer> blocks;
+        DescriptedBlockRange next; // range to prefetch next
+    };
+    // returns reply to be sent immediately if requested meanwhile
+    [[nodiscard]] std::optional<Reply> on_prefetched(const DescriptedBlockRange&, std::vector<BodyContainer>&&, ReadAheadBudget&);
+
+private:
+    std::optional<DescriptedBlockRange> last;
+    std::optional<DescriptedBlockRange> pending;
+    std::optional<uint32_t> pendingNonce; // set if peer already requested pending range
+    std::optional<Buffered> buffered;
+};
@@ -23,6 +23,12 @@ void Conref::send(Sndbuffer b)
         data.iter->second.c->asyncsend(std::move(b));
     }
 };
+void Conref::send(const SharedSndbuffer& b)
+{
+    if (!(*this)->c->eventloop_erased) {
+        data.iter->second.c->asyncsend(b);
+    }
+};
 
 Usage::Usage(HeaderDownload::Downloader& h, BlockDownload::Downloader& b)
     : data_headerdownload(h)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "eventloop/peer_chain.hpp"
+#include "eventloop/types/block_read_ahead.hpp"
 #include "eventloop/sync/block_download/connection_data.hpp"
 #include "eventloop/sync/header_download/connection_data.hpp"
 #include "eventloop/timer.hpp"
@@ -225,6 +226,7 @@ struct PeerState {
     SignedSnapshot::Priority acknowledgedSnapshotPriority;
     SignedSnapshot::Priority theirSnapshotPriority;
     uint32_t lastNonce;
+    BlockReadAhead blockReadAhead;
     bool verifiedEndpoint = false;
     Ping ping;
     Usage usage;
@@ -5,6 +5,9 @@
 #include <cassert>
 #include <cstring>
 #include <stdexcept>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 namespace {
 std::optional<uint16_t> parse_port(const std::string_view& s)
@@ -153,3 +156,12 @@ sockaddr_in EndpointAddress::sock_addr() const
     memcpy(&out.sin_addr.s_addr, &ntmp, 4);
     return out;
 }
+
+bool UnixSocketAddress::apply_mode() const
+{
+#ifdef _WIN32
+    return true;
+#else
+    return chmod(path.c_str(), mode) == 0;
+#endif
+}
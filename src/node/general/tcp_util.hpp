@@ -49,3 +49,11 @@ struct EndpointAddress {
     IPv4 ipv4;
     uint16_t port = 0;
 };
+
+// Unix domain socket for local clients, disabled if path is empty
+struct UnixSocketAddress {
+    std::string path;
+    uint32_t mode { 0660 }; // permission bits of the socket file
+    std::string to_string() const { return "unix:" + path; }
+    [[nodiscard]] bool apply_mode() const;
+};
@@ -0,0 +1,154 @@
+#include "threads.hpp"
+#ifdef __linux__
+#include "global/globals.hpp"
+#include "spdlog/spdlog.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+const char* role_name(ThreadRole r)
+{
+    switch (r) {
+    case ThreadRole::ApplyWorker:
+        return "apply-worker";
+    case ThreadRole::Chainserver:
+        return "chainserver";
+    case ThreadRole::Eventloop:
+        return "eventloop";
+    case ThreadRole::Network:
+        return "network";
+    case ThreadRole::Peerserver:
+        return "peerserver";
+    case ThreadRole::RPC:
+        return "rpc";
+    case ThreadRole::Stratum:
+        return "stratum";
+    }
+    return "unknown";
+}
+
+using sc = std::chrono::steady_clock;
+struct Registered {
+    ThreadRole role;
+    pid_t tid;
+    clockid_t clock;
+    int64_t lastCpuNs;
+    sc::time_point lastWall;
+};
+
+std::mutex m;
+std::vector<Registered> registered;
+
+int64_t cpu_ns(clockid_t clock)
+{
+    timespec ts;
+    if (clock_gettime(clock, &ts) != 0)
+        return 0;
+    return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+struct Registration {
+    pid_t tid { 0 };
+    ~Registration()
+    {
+        if (tid == 0)
+            return;
+        std::lock_guard l(m);
+        std::erase_if(registered, [&](const Registered& r) { return r.tid == tid; });
+    }
+};
+thread_local Registration registration;
+
+void read_ctx_switches(pid_t tid, ThreadStats& s)
+{
+    std::ifstream f("/proc/self/task/" + std::to_string(tid) + "/status");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.starts_with("voluntary_ctxt_switches:"))
+            s.voluntaryCtxSwitches = std::stoll(line.substr(24));
+        else if (line.starts_with("nonvoluntary_ctxt_switches:"))
+            s.involuntaryCtxSwitches = std::stoll(line.substr(27));
+    }
+}
+
+std::vector<int> affinity(pid_t tid)
+{
+    std::vector<int> out;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(tid, sizeof(set), &set) != 0)
+        return out;
+    for (int i = 0; i < CPU_SETSIZE; ++i)
+        if (CPU_ISSET(i, &set))
+            out.push_back(i);
+    return out;
+}
+}
+
+void setup_thread(ThreadRole role)
+{
+    const char* name { role_name(role) };
+    const pid_t tid = syscall(SYS_gettid);
+    // the main thread's name is the process name shown by ps, top and systemd
+    if (tid != getpid())
+        pthread_setname_np(pthread_self(), name);
+
+    // placement
+    auto& p { *config().threads.find(name) };
+    if (!p.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : p.cpus)
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+        if (int e = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); e != 0)
+            spdlog::warn("Cannot set CPU affinity of {} thread: {}", name, strerror(e));
+    }
+    if (p.nice) {
+        if (setpriority(PRIO_PROCESS, tid, *p.nice) != 0)
+            spdlog::warn("Cannot set priority of {} thread: {}", name, strerror(errno));
+    }
+
+    // register
+    clockid_t clock;
+    if (pthread_getcpuclockid(pthread_self(), &clock) != 0)
+        return;
+    std::lock_guard l(m);
+    registration.tid = tid;
+    registered.push_back({ role, tid, clock, cpu_ns(clock), sc::now() });
+}
+
+std::vector<ThreadStats> thread_stats()
+{
+    std::vector<ThreadStats> out;
+    std::lock_guard l(m);
+    const auto now { sc::now() };
+    for (auto& r : registered) {
+        const int64_t cpu { cpu_ns(r.clock) };
+        const double wall { std::chrono::duration<double>(now - r.lastWall).count() };
+        ThreadStats s {
+            .role = role_name(r.role),
+            .tid = r.tid,
+            .cpuSeconds = double(cpu) / 1e9,
+            .busyRatio = wall > 0 ? double(cpu - r.lastCpuNs) / 1e9 / wall : 0,
+            .cpus = affinity(r.tid),
+            .nice = getpriority(PRIO_PROCESS, r.tid)
+        };
+        read_ctx_switches(r.tid, s);
+        r.lastCpuNs = cpu;
+        r.lastWall = now;
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+#else
+void setup_thread(ThreadRole) { }
+std::vector<ThreadStats> thread_stats() { return {}; }
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class ThreadRole {
+    ApplyWorker,
+    Chainserver,
+    Eventloop,
+    Network,
+    Peerserver,
+    RPC,
+    Stratum
+};
+
+// Names the calling thread (except the main thread), applies the
+// configured CPU affinity and priority of its role and registers it for
+// thread_stats() until it exits.
+void setup_thread(ThreadRole);
+
+struct ThreadStats {
+    std::string role;
+    int64_t tid;
+    double cpuSeconds;
+    double busyRatio; // CPU time per wall time since the previous query
+    int64_t voluntaryCtxSwitches { -1 };
+    int64_t involuntaryCtxSwitches { -1 };
+    std::vector<int> cpus;
+    int nice;
+};
+std::vector<ThreadStats> thread_stats();
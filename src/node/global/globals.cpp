@@ -50,11 +50,13 @@ const Global& global()
     return globalinstance;
 }
 
-int init_config(int argc, char** argv)
+int init_config(int argc, char** argv, void (*adjust)(Config&))
 {
     auto& conf = globalinstance.conf;
     if (int i = conf.init(argc, argv))
         return i;
+    if (adjust)
+        adjust(conf);
     return 0;
 };
 
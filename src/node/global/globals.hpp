@@ -32,5 +32,5 @@ inline spdlog::logger& connection_log() { return *global().connLogger; }
 inline auto& timing_log() { return global().timingLogger.value(); }
 inline spdlog::logger& syncdebug_log() { return *global().syncdebugLogger; }
 const Config& config();
-int init_config(int argc, char** argv);
+int init_config(int argc, char** argv, void (*adjust)(Config&) = nullptr); // adjust may override parsed settings
 void global_init(BatchRegistry* pbr, PeerServer* pps, ChainServer* pcs, Conman* pcm, Eventloop* pel, HTTPEndpoint* httpEndpoint);
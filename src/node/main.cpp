@@ -6,6 +6,7 @@
 #include "db/peer_db.hpp"
 #include "eventloop/eventloop.hpp"
 #include "general/errors.hpp"
+#include "general/threads.hpp"
 #include "global/globals.hpp"
 #include "peerserver/peerserver.hpp"
 #include "spdlog/spdlog.h"
@@ -98,11 +99,13 @@ int main(int argc, char** argv)
 
     spdlog::debug("Opening chain database \"{}\"", config().data.chaindb);
     ChainDB db(config().data.chaindb);
+    if (!config().data.chaindb.empty())
+        breg.open_header_file(config().data.chaindb + ".headers");
     auto cs =ChainServer::make_chain_server(db, breg, config().node.snapshotSigner);
 
     std::optional<StratumServer> stratumServer;
     if (config().stratumPool) {
-        stratumServer.emplace(config().stratumPool->bind);
+        stratumServer.emplace(config().stratumPool->bind, config().stratumPool->unixSocket);
     }
     Eventloop el(ps, *cs, config());
     Conman cm(&l, ps, config());
@@ -113,19 +116,32 @@ int main(int argc, char** argv)
     spdlog::debug("Starting libuv loop");
 
     // starting endpoint
-    HTTPEndpoint endpoint { config().jsonrpc.bind };
+    HTTPEndpoint endpoint { config().jsonrpc.bind, config().jsonrpc.unixSocket };
     auto endpointPublic { HTTPEndpoint::make_public_endpoint(config())};
 
     // setup globals
     global_init(&breg, &ps, &*cs, &cm, &el, &endpoint);
 
+    // chain_delta subscribers at our tip can resume after a restart, the
+    // chain server pushes the head before any later block events
+    cs->async_get_head([&endpoint](const tl::expected<API::ChainHead, int32_t>& h) {
+        if (h)
+            endpoint.push_event(*h);
+    });
+
     // running eventloops
-    el.start_async_loop();
+    setup_thread(ThreadRole::Network);
+    if (config().node.singleThread)
+        el.start_uv_loop(&l);
+    else
+        el.start_async_loop();
     if ((i = uv_run(&l, UV_RUN_DEFAULT)))
         goto error;
     free_signals();
     if ((i = uv_run(&l, UV_RUN_DEFAULT)))
         goto error;
+    if (config().node.singleThread)
+        cs->shutdown_join(); // not joined on the libuv thread
     uv_loop_close(&l);
 
     return 0;
@@ -28,6 +28,23 @@ struct ComparatorFee {
         return i1->second.fee > i2->second.fee;
     }
 };
+struct ComparatorTime {
+    using const_iter_t = Txmap::const_iterator;
+    using is_transparent = std::true_type;
+    using Key = std::pair<uint32_t, TransactionId>;
+    inline bool operator()(const_iter_t i1, const_iter_t i2) const
+    {
+        return Key { i1->second.timestamp, i1->first } < Key { i2->second.timestamp, i2->first };
+    }
+    inline bool operator()(const_iter_t i1, const Key& k) const
+    {
+        return Key { i1->second.timestamp, i1->first } < k;
+    }
+    inline bool operator()(const Key& k, const_iter_t i2) const
+    {
+        return k < Key { i2->second.timestamp, i2->first };
+    }
+};
 struct ComparatorHash {
     using const_iter_t = Txmap::const_iterator;
     using is_transparent = std::true_type;
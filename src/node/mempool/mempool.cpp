@@ -1,5 +1,6 @@
 #include "mempool.hpp"
 #include "chainserver/transaction_ids.hpp"
+#include "general/now.hpp"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -44,6 +45,37 @@ std::vector<TransferTxExchangeMessage> Mempool::get_payments(size_t n, NonzeroHe
     return res;
 }
 
+Page Mempool::get_page(PageOrder order, const std::optional<PageCursor>& after, size_t limit) const
+{
+    assert(!master);
+    Page res;
+    auto collect = [&](auto begin, auto end, auto key) {
+        for (auto iter = begin; iter != end; ++iter) {
+            if (res.entries.size() >= limit) {
+                auto& last { res.entries.back() };
+                res.next = PageCursor { key(last.second), last.first };
+                break;
+            }
+            res.entries.push_back(**iter);
+        }
+    };
+    if (order == PageOrder::Fee) {
+        auto begin { byFee.begin() };
+        if (after) {
+            if (after->key > 0xFFFFu)
+                throw Error(EINV_ARGS);
+            begin = byFee.upper_bound(CompactUInt::from_value_throw(after->key), after->txid);
+        }
+        collect(begin, byFee.end(), [](const EntryValue& v) { return uint32_t(v.fee.value()); });
+    } else {
+        auto begin { byTime.begin() };
+        if (after)
+            begin = byTime.upper_bound(std::pair { after->key, after->txid });
+        collect(begin, byTime.end(), [](const EntryValue& v) { return v.timestamp; });
+    }
+    return res;
+}
+
 void Mempool::apply_log(const Log& log)
 {
     for (auto& l : log) {
@@ -62,6 +94,10 @@ void Mempool::apply_logevent(const Put& a)
     assert(byPin.insert(p.first).second);
     assert(byFee.insert(p.first));
     assert(byHash.insert(p.first).second);
+    if (!master) {
+        byTime.insert(p.first);
+        feeHistogram[p.first->second.fee.value() >> 10] += 1;
+    }
 }
 
 void Mempool::apply_logevent(const Erase& e)
@@ -100,6 +136,10 @@ bool Mempool::erase_internal(Txmap::const_iterator iter, BalanceEntries::iterato
     assert(byPin.erase(iter) == 1);
     assert(byFee.erase(iter) == 1);
     assert(byHash.erase(iter) == 1);
+    if (!master) {
+        byTime.erase(iter);
+        feeHistogram[iter->second.fee.value() >> 10] -= 1;
+    }
     txs().erase(iter);
 
     if (master)
@@ -252,7 +292,7 @@ void Mempool::insert_tx_throw(const TransferTxExchangeMessage& pm,
 
     e.lock(spend);
     auto [iter, inserted] = txs().try_emplace(pm.txid,
-        pm.reserved, pm.compactFee, pm.toAddr, pm.amount, pm.signature, txhash, txh);
+        pm.reserved, pm.compactFee, pm.toAddr, pm.amount, pm.signature, txhash, txh, now_timestamp());
     assert(inserted);
     if (master)
         log.push_back(Put { *iter });
@@ -2,6 +2,7 @@
 #include "comparators.hpp"
 #include "general/address_funds.hpp"
 #include "mempool/log.hpp"
+#include "mempool/page.hpp"
 #include <set>
 namespace chainserver {
 struct TransactionIds;
@@ -25,6 +26,11 @@ private:
     Funds used { Funds::zero() };
 };
 
+struct Page {
+    std::vector<Entry> entries;
+    std::optional<PageCursor> next;
+};
+
 class Mempool {
     using iter_t = Txmap::iterator;
     using const_iter_t = Txmap::const_iterator;
@@ -65,6 +71,10 @@ public:
     [[nodiscard]] size_t size() const { return txs.size(); }
     [[nodiscard]] CompactUInt min_fee() const;
 
+    // replica only
+    [[nodiscard]] Page get_page(PageOrder, const std::optional<PageCursor>& after, size_t limit) const;
+    [[nodiscard]] const FeeHistogram& fee_histogram() const { return feeHistogram; }
+
 private:
     using BalanceEntries = std::map<AccountId, BalanceEntry>;
     void apply_logevent(const Put&);
@@ -80,6 +90,11 @@ private:
     ByFeeDesc byFee;
     std::set<const_iter_t, ComparatorHash> byHash;
     BalanceEntries balanceEntries;
+
+    // indices only maintained in replica (!master) for API queries
+    std::set<const_iter_t, ComparatorTime> byTime;
+    FeeHistogram feeHistogram {};
+
     bool master;
     size_t maxSize;
 };
@@ -0,0 +1,39 @@
+#pragma once
+#include "block/body/transaction_id.hpp"
+#include "general/hex.hpp"
+#include "general/reader.hpp"
+#include "general/writer.hpp"
+#include <array>
+#include <optional>
+#include <string_view>
+
+namespace mempool {
+enum class PageOrder {
+    Fee, // descending
+    Time // ascending
+};
+
+// position of the last entry of a page
+struct PageCursor {
+    static constexpr size_t bytesize { 4 + TransactionId::bytesize };
+    uint32_t key; // compact fee or timestamp depending on PageOrder
+    TransactionId txid;
+
+    static PageCursor parse_throw(std::string_view s)
+    {
+        auto a { hex_to_arr<bytesize>(s) };
+        Reader r(a);
+        return { r.uint32(), TransactionId(r) };
+    }
+    std::string to_string() const
+    {
+        std::array<uint8_t, bytesize> a;
+        Writer w(a.data(), a.size());
+        w << key << txid;
+        return serialize_hex(a);
+    }
+};
+
+// counts per fee exponent, bucket i holds compact fee values in [i<<10, (i+1)<<10)
+using FeeHistogram = std::array<uint32_t, 64>;
+}
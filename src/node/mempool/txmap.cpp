@@ -16,9 +16,22 @@ auto Txmap::by_fee_inc(AccountId id) const -> std::vector<const_iterator>
     return iterators;
 };
 
+namespace {
+    bool fee_desc(CompactUInt fee1, const TransactionId& txid1, CompactUInt fee2, const TransactionId& txid2)
+    {
+        if (fee1 == fee2)
+            return txid1 < txid2;
+        return fee1 > fee2;
+    }
+    bool fee_desc(ByFeeDesc::const_iter_t i1, ByFeeDesc::const_iter_t i2)
+    {
+        return fee_desc(i1->second.fee, i1->first, i2->second.fee, i2->first);
+    }
+}
+
 bool ByFeeDesc::insert(const_iter_t iter)
 {
-    auto pos = std::lower_bound(data.begin(), data.end(), iter, [](const_iter_t i1, const_iter_t i2) { return i1->second.fee > i2->second.fee; });
+    auto pos = std::lower_bound(data.begin(), data.end(), iter, [](const_iter_t i1, const_iter_t i2) { return fee_desc(i1, i2); });
     if (pos != data.end() && *pos == iter)
         return false;
     data.insert(pos, iter);
@@ -27,7 +40,18 @@ bool ByFeeDesc::insert(const_iter_t iter)
 
 size_t ByFeeDesc::erase(const_iter_t iter)
 {
-    return std::erase(data, iter);
+    auto pos = std::lower_bound(data.begin(), data.end(), iter, [](const_iter_t i1, const_iter_t i2) { return fee_desc(i1, i2); });
+    if (pos == data.end() || *pos != iter)
+        return 0;
+    data.erase(pos);
+    return 1;
+}
+
+auto ByFeeDesc::upper_bound(CompactUInt fee, const TransactionId& txid) const -> iterator
+{
+    return std::upper_bound(data.begin(), data.end(), 0, [&](int, const_iter_t i) {
+        return fee_desc(fee, txid, i->second.fee, i->first);
+    });
 }
 
 auto ByFeeDesc::sample(size_t n, size_t k) const -> std::vector<const_iter_t>
@@ -28,8 +28,10 @@ public:
     auto& operator()() const { return _map; }
     [[nodiscard]] std::vector<const_iterator> by_fee_inc(AccountId) const;
 };
+// sorted by fee descending, ties by transaction id ascending
 struct ByFeeDesc {
     using const_iter_t = Txmap::const_iterator;
+    using iterator = std::vector<const_iter_t>::const_iterator;
     bool insert(const_iter_t iter);
     [[nodiscard]] size_t erase(const_iter_t iter);
     const_iter_t smallest() const { return data.back(); }
@@ -37,6 +39,8 @@ struct ByFeeDesc {
     size_t size() const { return data.size(); }
     auto begin() const { return data.begin(); }
     auto end() const { return data.end(); }
+    // first element ordered after (fee, txid)
+    iterator upper_bound(CompactUInt fee, const TransactionId& txid) const;
 
 private:
     std::vector<const_iter_t> data;
@@ -5,6 +5,7 @@
 #include "db/peer_db.hpp"
 #include "general/error_time.hpp"
 #include "general/now.hpp"
+#include "general/threads.hpp"
 
 using namespace std::chrono_literals;
 namespace {
@@ -35,6 +36,7 @@ void PeerServer::register_close(IPv4 address, ErrorTimestamp et, int64_t rowid)
 
 void PeerServer::work()
 {
+    setup_thread(ThreadRole::Peerserver);
     while (true) {
         decltype(events) tmpq;
         {
@@ -57,6 +59,8 @@ void PeerServer::work()
                     tmpq.front());
                 tmpq.pop();
             }
+            if (now >= nextPrune)
+                nextPrune = db.prune_logs(now) ? now : now + 60 * 60;
             t.commit();
         }
     }
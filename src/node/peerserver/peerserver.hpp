@@ -136,6 +136,7 @@ private:
     // private variables
     PeerDB& db;
     uint32_t now;
+    uint32_t nextPrune { 0 };
     BanCache bancache;
     void handle_event(Offense&&);
     void handle_event(Unban&&);
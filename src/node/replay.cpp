@@ -0,0 +1,109 @@
+// Replays a P2P traffic capture (see [node] capture-traffic) into a fresh
+// node for profiling. The chain database must be given explicitly and
+// should be a copy of the one the capturing node used when the capture
+// started, replayed blocks are written to it. The node is isolated and
+// listens on ephemeral local ports unless given otherwise. Event feed,
+// traffic capture and balance index are disabled.
+//
+// usage: wart-replay CAPTURE --chain-db=COPY [--speed=FACTOR] [node options]
+#include "api/http/endpoint.hpp"
+#include "asyncio/conman.hpp"
+#include "asyncio/traffic_replay.hpp"
+#include "chainserver/server.hpp"
+#include "db/chain_db.hpp"
+#include "db/peer_db.hpp"
+#include "eventloop/eventloop.hpp"
+#include "general/threads.hpp"
+#include "global/globals.hpp"
+#include "peerserver/peerserver.hpp"
+#include "spdlog/spdlog.h"
+
+#include <iostream>
+using namespace std;
+
+struct ECC {
+    ECC() { ECC_Start(); }
+    ~ECC() { ECC_Stop(); }
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " CAPTURE --chain-db=COPY [--speed=FACTOR] [node options]\n"
+             << "COPY is a copy of the capturing node's chain database, it is modified.\n"
+             << "FACTOR 0 replays as fast as possible, default is 1.\n";
+        return -1;
+    }
+    const std::string capture { argv[1] };
+    try {
+        traffic_capture::RecordReader check(capture);
+    } catch (const std::exception& e) {
+        cerr << e.what() << "\n";
+        return -1;
+    }
+    double speed { 1 };
+    std::vector<std::string> args { argv[0], "--isolated" };
+    bool bind { false }, rpc { false }, peersdb { false }, chaindb { false };
+    for (int i = 2; i < argc; ++i) {
+        std::string_view a { argv[i] };
+        if (a.starts_with("--speed=")) {
+            speed = std::stod(std::string(a.substr(8)));
+            continue;
+        }
+        bind |= a.starts_with("--bind") || a == "-b";
+        rpc |= a.starts_with("--rpc") || a == "-r";
+        peersdb |= a.starts_with("--peers-db");
+        chaindb |= a.starts_with("--chain-db");
+        args.push_back(std::string(a));
+    }
+    if (!chaindb) {
+        // never write replayed blocks into the node's own chain database
+        cerr << "--chain-db is required, use a copy of the capturing node's chain database\n";
+        return -1;
+    }
+    if (!bind)
+        args.push_back("--bind=127.0.0.1:0");
+    if (!rpc)
+        args.push_back("--rpc=127.0.0.1:0");
+    if (!peersdb)
+        args.push_back("--peers-db=" + capture + ".peers.db3");
+    std::vector<char*> cargs;
+    for (auto& a : args)
+        cargs.push_back(a.data());
+
+    ECC ecc;
+    int i = init_config(cargs.size(), cargs.data(), [](Config& c) {
+        // config.toml must not make the replay write to the node's outputs
+        c.node.eventFeed.clear();
+        c.node.captureTraffic.clear();
+        c.node.balanceIndex = false;
+    });
+    if (i <= 0)
+        return i; // >0 means continue with execution
+    BatchRegistry breg;
+
+    uv_loop_t l;
+    uv_loop_init(&l);
+
+    PeerDB pdb(config().data.peersdb);
+    PeerServer ps(pdb, config());
+    ChainDB db(config().data.chaindb);
+    if (!config().data.chaindb.empty())
+        breg.open_header_file(config().data.chaindb + ".headers");
+    auto cs = ChainServer::make_chain_server(db, breg, config().node.snapshotSigner);
+    Eventloop el(ps, *cs, config());
+    Conman cm(&l, ps, config());
+    HTTPEndpoint endpoint { config().jsonrpc.bind, config().jsonrpc.unixSocket };
+    global_init(&breg, &ps, &*cs, &cm, &el, &endpoint);
+
+    setup_thread(ThreadRole::Network);
+    TrafficReplay replay(cm, capture, speed);
+    el.start_async_loop();
+    if ((i = uv_run(&l, UV_RUN_DEFAULT)))
+        goto error;
+    uv_loop_close(&l);
+    return 0;
+error:
+    spdlog::error("libuv error: {}", errors::err_name(i));
+    return i;
+}
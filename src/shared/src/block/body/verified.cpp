@@ -0,0 +1,10 @@
+#include "verified.hpp"
+
+std::optional<VerifiedBody> VerifiedBody::verify(BodyContainer body, NonzeroHeight h)
+{
+    const auto bv { body.view(h) };
+    if (!bv.valid())
+        return {};
+    const auto merkleRoot { bv.merkle_root(h) };
+    return VerifiedBody { std::move(body), h, merkleRoot };
+}
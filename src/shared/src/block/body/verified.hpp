@@ -0,0 +1,37 @@
+#pragma once
+#include "block/body/container.hpp"
+#include "block/body/view.hpp"
+#include "block/header/header.hpp"
+#include "crypto/hash.hpp"
+#include <optional>
+
+// Token for a body that was parsed and merkle-hashed once. It is created
+// when a block is downloaded and consumed on staging such that the chain
+// server does not need to parse and hash the body again.
+class VerifiedBody {
+public:
+    // returns nullopt if the body structure is invalid
+    [[nodiscard]] static std::optional<VerifiedBody> verify(BodyContainer, NonzeroHeight);
+
+    NonzeroHeight height() const { return h; }
+    const Hash& merkle_root() const { return merkleRoot; }
+    size_t size() const { return body.size(); }
+    BodyContainer release() && { return std::move(body); }
+
+private:
+    VerifiedBody(BodyContainer body, NonzeroHeight h, Hash merkleRoot)
+        : body(std::move(body))
+        , h(h)
+        , merkleRoot(merkleRoot)
+    {
+    }
+    BodyContainer body;
+    NonzeroHeight h;
+    Hash merkleRoot;
+};
+
+struct VerifiedBlock {
+    Header header;
+    VerifiedBody body;
+    NonzeroHeight height() const { return body.height(); }
+};
@@ -0,0 +1,61 @@
+#include "janus_midstate.hpp"
+#include "block/header/header_impl.hpp"
+#include "crypto/hasher_sha256.hpp"
+#include "general/byte_order.hpp"
+
+namespace {
+constexpr size_t prefixLen { 64 }; // one SHA-256 block, does not contain the nonce
+constexpr size_t suffixLen { HeaderView::bytesize - prefixLen };
+static_assert(HeaderView::offset_nonce >= prefixLen);
+}
+
+JanusMidstate::JanusMidstate(const Header& tmpl, POWVersion version)
+    : tmpl(tmpl)
+    , version(version)
+{
+    sha256_Init(&sha);
+    sha256_Update(&sha, tmpl.data(), prefixLen);
+    verus.write(tmpl.data(), prefixLen);
+}
+
+Header JanusMidstate::header(uint32_t nonce) const
+{
+    Header h { tmpl };
+    const uint32_t n { hton32(nonce) };
+    memcpy(h.data() + HeaderView::offset_nonce, &n, 4);
+    return h;
+}
+
+Hash JanusMidstate::sha_hash(const Header& h) const
+{
+    SHA256_CTX ctx { sha };
+    sha256_Update(&ctx, h.data() + prefixLen, suffixLen);
+    Hash first;
+    sha256_Final(&ctx, first.data());
+    return hashSHA256(first.data(), first.size());
+}
+
+Hash JanusMidstate::hash(uint32_t nonce) const
+{
+    return sha_hash(header(nonce));
+}
+
+bool JanusMidstate::valid(uint32_t nonce) const
+{
+    const auto h { header(nonce) };
+    Hash verusHash {};
+    if (!version.is_original()) {
+        Verus::VerusHasher vh { verus };
+        verusHash = vh.write(h.data() + prefixLen, suffixLen).finalize(version.uses_verus_2_2());
+    }
+    return HeaderView(h.data()).validPOW(sha_hash(h), verusHash, version);
+}
+
+std::optional<uint32_t> JanusMidstate::scan(uint32_t begin, uint32_t end) const
+{
+    for (uint32_t n = begin; n < end; ++n) {
+        if (valid(n))
+            return n;
+    }
+    return {};
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "block/header/header.hpp"
+#include "block/header/pow_version.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/verushash/verushash.hpp"
+#include "sha2.hpp"
+#include <optional>
+
+// Nonce-independent hash state of a header template. Only the last 16
+// header bytes (which contain the nonce) are hashed per evaluation, the
+// first 64 bytes are absorbed once by both SHA-256 and VerusHash. Results
+// are identical to HeaderView::validPOW on the header with that nonce.
+// Nonces are interpreted like HeaderView::nonce().
+class JanusMidstate {
+public:
+    JanusMidstate(const Header& tmpl, POWVersion version);
+
+    [[nodiscard]] Header header(uint32_t nonce) const;
+    [[nodiscard]] Hash hash(uint32_t nonce) const; // same as header(nonce).hash()
+    [[nodiscard]] bool valid(uint32_t nonce) const;
+
+    // first nonce in [begin, end) with valid proof of work
+    [[nodiscard]] std::optional<uint32_t> scan(uint32_t begin, uint32_t end) const;
+
+private:
+    Hash sha_hash(const Header&) const;
+
+    Header tmpl;
+    POWVersion version;
+    SHA256_CTX sha;
+    Verus::VerusHasher verus;
+};
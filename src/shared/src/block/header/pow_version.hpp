@@ -27,6 +27,10 @@ public:
     {
         return std::visit(lambda, data);
     }
+    [[nodiscard]] bool is_original() const
+    {
+        return std::holds_alternative<Original>(data);
+    }
     [[nodiscard]] bool uses_verus_2_2() const
     {
         return visit([](auto& e) { return e.verusv2_2; });
@@ -42,9 +42,9 @@ inline bool operator<(const CustomFloat& hashproduct, TargetV2 t)
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus6>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus6>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusFloat { CustomFloat(verus2_1_hash()) };
+    auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     constexpr auto c = CustomFloat(-7, 2748779069); // 0.005
     if (sha256tFloat < c) {
@@ -56,9 +56,9 @@ bool HeaderView::validPOW<POWVersion::Janus6>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus7>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus7>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusFloat { CustomFloat(verus2_1_hash()) };
+    auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     {
         constexpr auto c = CustomFloat(-7, 2748779069); // 0.005
@@ -72,15 +72,14 @@ bool HeaderView::validPOW<POWVersion::Janus7>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Original>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Original>(const Hash& h, const Hash&) const
 {
     return target_v1().compatible(h);
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus1>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus1>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusHash { verus2_1_hash() };
     auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     auto hashProduct { verusFloat * sha256tFloat };
@@ -88,9 +87,8 @@ bool HeaderView::validPOW<POWVersion::Janus1>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus2>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus2>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusHash { verus2_1_hash() };
     auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     constexpr auto factor { CustomFloat(0, 3006477107) }; // = 0.7 <-- this can be decreased if necessary
@@ -99,9 +97,8 @@ bool HeaderView::validPOW<POWVersion::Janus2>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus3>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus3>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusHash { verus2_1_hash() };
     auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     constexpr auto factor { CustomFloat(0, 3006477107) };
@@ -114,9 +111,8 @@ bool HeaderView::validPOW<POWVersion::Janus3>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus4>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus4>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusHash { verus2_1_hash() };
     auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     constexpr auto factor { CustomFloat(0, 3006477107) };
@@ -129,9 +125,8 @@ bool HeaderView::validPOW<POWVersion::Janus4>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus5>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus5>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusHash { verus2_1_hash() };
     auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     constexpr auto factor { CustomFloat(0, 3006477107) };
@@ -147,9 +142,9 @@ bool HeaderView::validPOW<POWVersion::Janus5>(const Hash& h) const
 }
 
 template <>
-bool HeaderView::validPOW<POWVersion::Janus8>(const Hash& h) const
+bool HeaderView::validPOW<POWVersion::Janus8>(const Hash& h, const Hash& verusHash) const
 {
-    auto verusFloat { CustomFloat(verus2_2_hash()) };
+    auto verusFloat { CustomFloat(verusHash) };
     auto sha256tFloat { CustomFloat(hashSHA256(h)) };
     {
         constexpr auto c = CustomFloat(-7, 2748779069); // 0.005
@@ -165,7 +160,18 @@ bool HeaderView::validPOW<POWVersion::Janus8>(const Hash& h) const
 bool HeaderView::validPOW(const Hash& h, POWVersion version) const
 {
     return version.visit([this, &h](auto version) -> bool {
-        return validPOW<std::remove_cv_t<decltype(version)>>(h);
+        using T = std::remove_cv_t<decltype(version)>;
+        if constexpr (std::is_same_v<T, POWVersion::Original>)
+            return validPOW<T>(h, h); // no verus hash needed
+        else
+            return validPOW<T>(h, T::verusv2_2 ? verus2_2_hash() : verus2_1_hash());
+    });
+}
+
+bool HeaderView::validPOW(const Hash& h, const Hash& verusHash, POWVersion version) const
+{
+    return version.visit([this, &h, &verusHash](auto version) -> bool {
+        return validPOW<std::remove_cv_t<decltype(version)>>(h, verusHash);
     });
 }
 
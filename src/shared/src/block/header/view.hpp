@@ -33,6 +33,9 @@ public:
     inline Target target(NonzeroHeight h, bool testnet) const;
 
     bool validPOW(const Hash& h, POWVersion v) const;
+    // verusHash must be the verus hash used by v (2.1 or 2.2), ignored for
+    // the original proof of work
+    bool validPOW(const Hash& h, const Hash& verusHash, POWVersion v) const;
 
     double janus_number() const;
     Hash verus2_1_hash() const;
@@ -61,7 +64,7 @@ public:
 
 private:
     template <typename T>
-    bool validPOW(const Hash& h) const;
+    bool validPOW(const Hash& h, const Hash& verusHash) const;
 
 private:
     TargetV1 target_v1() const;
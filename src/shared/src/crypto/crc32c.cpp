@@ -0,0 +1,111 @@
+#include "crc32c.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define CRC32C_X86
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32C_ARM
+#endif
+
+namespace {
+constexpr uint32_t poly = 0x82f63b78; // reversed Castagnoli polynomial
+
+constexpr auto make_tables()
+{
+    std::array<std::array<uint32_t, 256>, 8> t {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k)
+            c = (c >> 1) ^ (poly & (0u - (c & 1)));
+        t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+        for (size_t s = 1; s < 8; ++s)
+            t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xff];
+    return t;
+}
+constexpr auto tables { make_tables() };
+
+#ifdef CRC32C_X86
+__attribute__((target("sse4.2"))) uint32_t crc32c_hw(const uint8_t* p, size_t len, uint32_t crc)
+{
+#ifdef __x86_64__
+    uint64_t c = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+    crc = uint32_t(c);
+#endif
+    for (; len > 0; --len, ++p)
+        crc = _mm_crc32_u8(crc, *p);
+    return crc;
+}
+bool detect_hw()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_SSE4_2) != 0;
+}
+#elif defined(CRC32C_ARM)
+uint32_t crc32c_hw(const uint8_t* p, size_t len, uint32_t crc)
+{
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+    for (; len > 0; --len, ++p)
+        crc = __crc32cb(crc, *p);
+    return crc;
+}
+bool detect_hw() { return true; }
+#else
+uint32_t crc32c_hw(const uint8_t* p, size_t len, uint32_t crc)
+{
+    return crc32c_portable(p, len, crc);
+}
+bool detect_hw() { return false; }
+#endif
+
+const bool hardware { detect_hw() };
+} // namespace
+
+uint32_t crc32c_portable(const uint8_t* p, size_t len, uint32_t crc)
+{
+    crc = ~crc;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; len >= 8; len -= 8, p += 8) {
+            uint32_t lo, hi;
+            memcpy(&lo, p, 4);
+            memcpy(&hi, p + 4, 4);
+            lo ^= crc;
+            crc = tables[7][lo & 0xff] ^ tables[6][(lo >> 8) & 0xff]
+                ^ tables[5][(lo >> 16) & 0xff] ^ tables[4][lo >> 24]
+                ^ tables[3][hi & 0xff] ^ tables[2][(hi >> 8) & 0xff]
+                ^ tables[1][(hi >> 16) & 0xff] ^ tables[0][hi >> 24];
+        }
+    }
+    for (; len > 0; --len, ++p)
+        crc = (crc >> 8) ^ tables[0][(crc ^ *p) & 0xff];
+    return ~crc;
+}
+
+uint32_t crc32c(const uint8_t* data, size_t len, uint32_t crc)
+{
+    if (hardware)
+        return ~crc32c_hw(data, len, ~crc);
+    return crc32c_portable(data, len, crc);
+}
+
+bool crc32c_hardware_accelerated()
+{
+    return hardware;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// CRC-32C (Castagnoli). Uses SSE4.2 or ARMv8 CRC instructions when
+// available (detected once), otherwise a portable slicing-by-8 fallback.
+[[nodiscard]] uint32_t crc32c(const uint8_t* data, size_t len, uint32_t crc = 0);
+[[nodiscard]] inline uint32_t crc32c(std::span<const uint8_t> s, uint32_t crc = 0)
+{
+    return crc32c(s.data(), s.size(), crc);
+}
+
+[[nodiscard]] uint32_t crc32c_portable(const uint8_t* data, size_t len, uint32_t crc = 0);
+[[nodiscard]] bool crc32c_hardware_accelerated();
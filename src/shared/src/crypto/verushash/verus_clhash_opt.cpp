@@ -0,0 +1,224 @@
+#include "verus_clhash_opt.hpp"
+#include "verus_clhash_port.hpp"
+#include "verus_constants.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VERUS_OPT_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define VERUS_OPT_ARM
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+#if defined(VERUS_OPT_X86) || defined(VERUS_OPT_ARM)
+
+// Everything below is compiled for the instruction set extensions and is
+// only reached after verus_opt_supported() returned true.
+#if defined(VERUS_OPT_X86)
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("aes,pclmul,ssse3"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("aes,pclmul,ssse3")
+#endif
+#else
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("crypto"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("+crypto")
+#endif
+#endif
+
+namespace {
+#if defined(VERUS_OPT_X86)
+inline __m128i aesenc(__m128i s, __m128i k)
+{
+    return _mm_aesenc_si128(s, k);
+}
+#define clmul(a, b, imm) _mm_clmulepi64_si128(a, b, imm)
+#else
+// AESE xors the key before SubBytes/ShiftRows, AES-NI after MixColumns
+inline __m128i aesenc(__m128i s, __m128i k)
+{
+    uint8x16_t r { vaesmcq_u8(vaeseq_u8(vreinterpretq_u8_m128i(s), vdupq_n_u8(0))) };
+    return vreinterpretq_m128i_u8(veorq_u8(r, vreinterpretq_u8_m128i(k)));
+}
+#define clmul(a, b, imm)                                                  \
+    vreinterpretq_m128i_u64(vreinterpretq_u64_p128(vmull_p64(             \
+        (poly64_t)vgetq_lane_u64(vreinterpretq_u64_m128i(a), (imm) & 1), \
+        (poly64_t)vgetq_lane_u64(vreinterpretq_u64_m128i(b), ((imm) >> 4) & 1))))
+#endif
+
+const __m128i* const haraka_rc128 { reinterpret_cast<const __m128i*>(Verus::haraka_rc) };
+
+inline void haraka512_perm(__m128i s[4], const __m128i* rc)
+{
+    for (int i = 0; i < 5; ++i) {
+        // aes rounds
+        for (int j = 0; j < 2; ++j) {
+            s[0] = aesenc(s[0], rc[4 * 2 * i + 4 * j]);
+            s[1] = aesenc(s[1], rc[4 * 2 * i + 4 * j + 1]);
+            s[2] = aesenc(s[2], rc[4 * 2 * i + 4 * j + 2]);
+            s[3] = aesenc(s[3], rc[4 * 2 * i + 4 * j + 3]);
+        }
+
+        // mixing
+        const __m128i tmp { _mm_unpacklo_epi32(s[0], s[1]) };
+        s[0] = _mm_unpackhi_epi32(s[0], s[1]);
+        s[1] = _mm_unpacklo_epi32(s[2], s[3]);
+        s[2] = _mm_unpackhi_epi32(s[2], s[3]);
+        s[3] = _mm_unpacklo_epi32(s[0], s[2]);
+        s[0] = _mm_unpackhi_epi32(s[0], s[2]);
+        s[2] = _mm_unpackhi_epi32(s[1], tmp);
+        s[1] = _mm_unpacklo_epi32(s[1], tmp);
+    }
+}
+
+inline void haraka512_impl(unsigned char* out, const unsigned char* in, const __m128i* rc)
+{
+    __m128i s[4];
+    for (int i = 0; i < 4; ++i)
+        s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+    haraka512_perm(s, rc);
+
+    // feed-forward
+    alignas(16) unsigned char buf[64];
+    for (int i = 0; i < 4; ++i)
+        _mm_store_si128(reinterpret_cast<__m128i*>(buf) + i,
+            _mm_xor_si128(s[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i)));
+
+    // truncated
+    memcpy(out, buf + 8, 8);
+    memcpy(out + 8, buf + 24, 8);
+    memcpy(out + 16, buf + 32, 8);
+    memcpy(out + 24, buf + 48, 8);
+}
+
+// operations used by the shared verusclhash body
+#define _mm_clmulepi64_si128_emu(a, b, imm) clmul(a, b, imm)
+#define _mm_mulhrs_epi16_emu(a, b) _mm_mulhrs_epi16(a, b)
+#define _mm_set_epi64x_emu(hi, lo) _mm_set_epi64x(hi, lo)
+#define _mm_cvtsi64_si128_emu(a) _mm_cvtsi64_si128(a)
+#define _mm_cvtsi128_si64_emu(a) _mm_cvtsi128_si64(a)
+#define _mm_cvtsi32_si128_emu(a) _mm_cvtsi32_si128(a)
+#define _mm_setr_epi8_emu _mm_setr_epi8
+#define _mm_srli_si128_emu(a, imm) _mm_srli_si128(a, imm)
+#define _mm_xor_si128_emu(a, b) _mm_xor_si128(a, b)
+#define _mm_load_si128_emu(p) _mm_load_si128((const __m128i*)(p))
+#define _mm_store_si128_emu(p, v) _mm_store_si128((__m128i*)(p), v)
+#define _mm_shuffle_epi8_emu(a, b) _mm_shuffle_epi8(a, b)
+
+#define AES2_EMU(s0, s1, rci)          \
+    s0 = aesenc(s0, rc[rci]);     \
+    s1 = aesenc(s1, rc[rci + 1]); \
+    s0 = aesenc(s0, rc[rci + 2]); \
+    s1 = aesenc(s1, rc[rci + 3]);
+
+#define MIX2_EMU(s0, s1)                 \
+    tmp = _mm_unpacklo_epi32(s0, s1); \
+    s1 = _mm_unpackhi_epi32(s0, s1);  \
+    s0 = tmp;
+}
+
+#define VERUS_IMPL(name) name##_opt
+#include "verus_clhash_impl.hpp"
+
+void haraka512_opt(unsigned char* out, const unsigned char* in)
+{
+    haraka512_impl(out, in, haraka_rc128);
+}
+
+void haraka512_opt_keyed(unsigned char* out, const unsigned char* in,
+    const u128* rc)
+{
+    haraka512_impl(out, in, rc);
+}
+
+void haraka256_opt(unsigned char* out, const unsigned char* in)
+{
+    const __m128i* rc { haraka_rc128 };
+    __m128i s[2];
+    for (int i = 0; i < 2; ++i)
+        s[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i);
+
+    for (int i = 0; i < 5; ++i) {
+        // aes rounds
+        for (int j = 0; j < 2; ++j) {
+            s[0] = aesenc(s[0], rc[2 * 2 * i + 2 * j]);
+            s[1] = aesenc(s[1], rc[2 * 2 * i + 2 * j + 1]);
+        }
+
+        // mixing
+        const __m128i tmp { _mm_unpacklo_epi32(s[0], s[1]) };
+        s[1] = _mm_unpackhi_epi32(s[0], s[1]);
+        s[0] = tmp;
+    }
+
+    // feed-forward
+    for (int i = 0; i < 2; ++i)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out) + i,
+            _mm_xor_si128(s[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(in) + i)));
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+bool verus_opt_supported()
+{
+#if defined(VERUS_OPT_X86)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    constexpr unsigned int required { bit_AES | bit_PCLMUL | bit_SSSE3 };
+    return (ecx & required) == required;
+#elif defined(__APPLE__)
+    return true;
+#elif defined(__linux__)
+    const unsigned long hwcaps { getauxval(AT_HWCAP) };
+    return (hwcaps & HWCAP_AES) && (hwcaps & HWCAP_PMULL);
+#else
+    return false;
+#endif
+}
+
+#else
+bool verus_opt_supported() { return false; }
+
+uint64_t verusclhash_sv2_1_opt(void* random, const unsigned char buf[64],
+    uint64_t keyMask, __m128i** pMoveScratch)
+{
+    return verusclhash_sv2_1_port(random, buf, keyMask, pMoveScratch);
+}
+
+uint64_t verusclhash_sv2_2_opt(void* random, const unsigned char buf[64],
+    uint64_t keyMask, __m128i** pMoveScratch)
+{
+    return verusclhash_sv2_2_port(random, buf, keyMask, pMoveScratch);
+}
+
+void haraka512_opt(unsigned char* out, const unsigned char* in)
+{
+    haraka512_port(out, in);
+}
+
+void haraka512_opt_keyed(unsigned char* out, const unsigned char* in,
+    const u128* rc)
+{
+    haraka512_port_keyed(out, in, rc);
+}
+
+void haraka256_opt(unsigned char* out, const unsigned char* in)
+{
+    haraka256_port(out, in);
+}
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#include "u128.h"
+#include <cstdint>
+
+// Hardware accelerated counterparts of the functions in
+// verus_clhash_port.hpp using AES-NI/PCLMUL/SSSE3 on x86-64 and the
+// ARMv8 cryptography extension on aarch64. They must only be called if
+// verus_opt_supported() returns true, results are bit-for-bit identical to
+// the portable versions.
+[[nodiscard]] bool verus_opt_supported();
+
+uint64_t verusclhash_sv2_1_opt(void *random, const unsigned char buf[64],
+                               uint64_t keyMask, __m128i **pMoveScratch);
+
+uint64_t verusclhash_sv2_2_opt(void *random, const unsigned char buf[64],
+                               uint64_t keyMask, __m128i **pMoveScratch);
+
+void haraka512_opt(unsigned char *out, const unsigned char *in);
+
+void haraka512_opt_keyed(unsigned char *out, const unsigned char *in,
+                         const u128 *rc);
+
+void haraka256_opt(unsigned char *out, const unsigned char *in);
@@ -118,87 +118,7 @@ static const uint32_t saes_table[4][256] = {
     saes_data(saes_u0), saes_data(saes_u1), saes_data(saes_u2),
     saes_data(saes_u3)};
 
-static const unsigned char rc[40][16] = {
-    {0x9d, 0x7b, 0x81, 0x75, 0xf0, 0xfe, 0xc5, 0xb2, 0x0a, 0xc0, 0x20, 0xe6,
-     0x4c, 0x70, 0x84, 0x06},
-    {0x17, 0xf7, 0x08, 0x2f, 0xa4, 0x6b, 0x0f, 0x64, 0x6b, 0xa0, 0xf3, 0x88,
-     0xe1, 0xb4, 0x66, 0x8b},
-    {0x14, 0x91, 0x02, 0x9f, 0x60, 0x9d, 0x02, 0xcf, 0x98, 0x84, 0xf2, 0x53,
-     0x2d, 0xde, 0x02, 0x34},
-    {0x79, 0x4f, 0x5b, 0xfd, 0xaf, 0xbc, 0xf3, 0xbb, 0x08, 0x4f, 0x7b, 0x2e,
-     0xe6, 0xea, 0xd6, 0x0e},
-    {0x44, 0x70, 0x39, 0xbe, 0x1c, 0xcd, 0xee, 0x79, 0x8b, 0x44, 0x72, 0x48,
-     0xcb, 0xb0, 0xcf, 0xcb},
-    {0x7b, 0x05, 0x8a, 0x2b, 0xed, 0x35, 0x53, 0x8d, 0xb7, 0x32, 0x90, 0x6e,
-     0xee, 0xcd, 0xea, 0x7e},
-    {0x1b, 0xef, 0x4f, 0xda, 0x61, 0x27, 0x41, 0xe2, 0xd0, 0x7c, 0x2e, 0x5e,
-     0x43, 0x8f, 0xc2, 0x67},
-    {0x3b, 0x0b, 0xc7, 0x1f, 0xe2, 0xfd, 0x5f, 0x67, 0x07, 0xcc, 0xca, 0xaf,
-     0xb0, 0xd9, 0x24, 0x29},
-    {0xee, 0x65, 0xd4, 0xb9, 0xca, 0x8f, 0xdb, 0xec, 0xe9, 0x7f, 0x86, 0xe6,
-     0xf1, 0x63, 0x4d, 0xab},
-    {0x33, 0x7e, 0x03, 0xad, 0x4f, 0x40, 0x2a, 0x5b, 0x64, 0xcd, 0xb7, 0xd4,
-     0x84, 0xbf, 0x30, 0x1c},
-    {0x00, 0x98, 0xf6, 0x8d, 0x2e, 0x8b, 0x02, 0x69, 0xbf, 0x23, 0x17, 0x94,
-     0xb9, 0x0b, 0xcc, 0xb2},
-    {0x8a, 0x2d, 0x9d, 0x5c, 0xc8, 0x9e, 0xaa, 0x4a, 0x72, 0x55, 0x6f, 0xde,
-     0xa6, 0x78, 0x04, 0xfa},
-    {0xd4, 0x9f, 0x12, 0x29, 0x2e, 0x4f, 0xfa, 0x0e, 0x12, 0x2a, 0x77, 0x6b,
-     0x2b, 0x9f, 0xb4, 0xdf},
-    {0xee, 0x12, 0x6a, 0xbb, 0xae, 0x11, 0xd6, 0x32, 0x36, 0xa2, 0x49, 0xf4,
-     0x44, 0x03, 0xa1, 0x1e},
-    {0xa6, 0xec, 0xa8, 0x9c, 0xc9, 0x00, 0x96, 0x5f, 0x84, 0x00, 0x05, 0x4b,
-     0x88, 0x49, 0x04, 0xaf},
-    {0xec, 0x93, 0xe5, 0x27, 0xe3, 0xc7, 0xa2, 0x78, 0x4f, 0x9c, 0x19, 0x9d,
-     0xd8, 0x5e, 0x02, 0x21},
-    {0x73, 0x01, 0xd4, 0x82, 0xcd, 0x2e, 0x28, 0xb9, 0xb7, 0xc9, 0x59, 0xa7,
-     0xf8, 0xaa, 0x3a, 0xbf},
-    {0x6b, 0x7d, 0x30, 0x10, 0xd9, 0xef, 0xf2, 0x37, 0x17, 0xb0, 0x86, 0x61,
-     0x0d, 0x70, 0x60, 0x62},
-    {0xc6, 0x9a, 0xfc, 0xf6, 0x53, 0x91, 0xc2, 0x81, 0x43, 0x04, 0x30, 0x21,
-     0xc2, 0x45, 0xca, 0x5a},
-    {0x3a, 0x94, 0xd1, 0x36, 0xe8, 0x92, 0xaf, 0x2c, 0xbb, 0x68, 0x6b, 0x22,
-     0x3c, 0x97, 0x23, 0x92},
-    {0xb4, 0x71, 0x10, 0xe5, 0x58, 0xb9, 0xba, 0x6c, 0xeb, 0x86, 0x58, 0x22,
-     0x38, 0x92, 0xbf, 0xd3},
-    {0x8d, 0x12, 0xe1, 0x24, 0xdd, 0xfd, 0x3d, 0x93, 0x77, 0xc6, 0xf0, 0xae,
-     0xe5, 0x3c, 0x86, 0xdb},
-    {0xb1, 0x12, 0x22, 0xcb, 0xe3, 0x8d, 0xe4, 0x83, 0x9c, 0xa0, 0xeb, 0xff,
-     0x68, 0x62, 0x60, 0xbb},
-    {0x7d, 0xf7, 0x2b, 0xc7, 0x4e, 0x1a, 0xb9, 0x2d, 0x9c, 0xd1, 0xe4, 0xe2,
-     0xdc, 0xd3, 0x4b, 0x73},
-    {0x4e, 0x92, 0xb3, 0x2c, 0xc4, 0x15, 0x14, 0x4b, 0x43, 0x1b, 0x30, 0x61,
-     0xc3, 0x47, 0xbb, 0x43},
-    {0x99, 0x68, 0xeb, 0x16, 0xdd, 0x31, 0xb2, 0x03, 0xf6, 0xef, 0x07, 0xe7,
-     0xa8, 0x75, 0xa7, 0xdb},
-    {0x2c, 0x47, 0xca, 0x7e, 0x02, 0x23, 0x5e, 0x8e, 0x77, 0x59, 0x75, 0x3c,
-     0x4b, 0x61, 0xf3, 0x6d},
-    {0xf9, 0x17, 0x86, 0xb8, 0xb9, 0xe5, 0x1b, 0x6d, 0x77, 0x7d, 0xde, 0xd6,
-     0x17, 0x5a, 0xa7, 0xcd},
-    {0x5d, 0xee, 0x46, 0xa9, 0x9d, 0x06, 0x6c, 0x9d, 0xaa, 0xe9, 0xa8, 0x6b,
-     0xf0, 0x43, 0x6b, 0xec},
-    {0xc1, 0x27, 0xf3, 0x3b, 0x59, 0x11, 0x53, 0xa2, 0x2b, 0x33, 0x57, 0xf9,
-     0x50, 0x69, 0x1e, 0xcb},
-    {0xd9, 0xd0, 0x0e, 0x60, 0x53, 0x03, 0xed, 0xe4, 0x9c, 0x61, 0xda, 0x00,
-     0x75, 0x0c, 0xee, 0x2c},
-    {0x50, 0xa3, 0xa4, 0x63, 0xbc, 0xba, 0xbb, 0x80, 0xab, 0x0c, 0xe9, 0x96,
-     0xa1, 0xa5, 0xb1, 0xf0},
-    {0x39, 0xca, 0x8d, 0x93, 0x30, 0xde, 0x0d, 0xab, 0x88, 0x29, 0x96, 0x5e,
-     0x02, 0xb1, 0x3d, 0xae},
-    {0x42, 0xb4, 0x75, 0x2e, 0xa8, 0xf3, 0x14, 0x88, 0x0b, 0xa4, 0x54, 0xd5,
-     0x38, 0x8f, 0xbb, 0x17},
-    {0xf6, 0x16, 0x0a, 0x36, 0x79, 0xb7, 0xb6, 0xae, 0xd7, 0x7f, 0x42, 0x5f,
-     0x5b, 0x8a, 0xbb, 0x34},
-    {0xde, 0xaf, 0xba, 0xff, 0x18, 0x59, 0xce, 0x43, 0x38, 0x54, 0xe5, 0xcb,
-     0x41, 0x52, 0xf6, 0x26},
-    {0x78, 0xc9, 0x9e, 0x83, 0xf7, 0x9c, 0xca, 0xa2, 0x6a, 0x02, 0xf3, 0xb9,
-     0x54, 0x9a, 0xe9, 0x4c},
-    {0x35, 0x12, 0x90, 0x22, 0x28, 0x6e, 0xc0, 0x40, 0xbe, 0xf7, 0xdf, 0x1b,
-     0x1a, 0xa5, 0x51, 0xae},
-    {0xcf, 0x59, 0xa6, 0x48, 0x0f, 0xbc, 0x73, 0xc1, 0x2b, 0xd2, 0x7e, 0xba,
-     0x3c, 0x61, 0xc1, 0xa0},
-    {0xa1, 0x9d, 0xc5, 0xe9, 0xfd, 0xbd, 0xd6, 0x4a, 0x88, 0x82, 0x28, 0x02,
-     0x03, 0xcc, 0x6a, 0x75}};
+const auto& rc { Verus::haraka_rc };
 
 // static const unsigned char sbox[256] = {
 //     0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b,
@@ -790,924 +710,6 @@ __m128i _mm_shuffle_epi8_emu(__m128i a, __m128i b) {
 }
 
 }
-// portable
-static inline __m128i lazyLengthHash_port(uint64_t keylength, uint64_t length) {
-  const __m128i lengthvector = _mm_set_epi64x_emu(keylength, length);
-  const __m128i clprod1 =
-      _mm_clmulepi64_si128_emu(lengthvector, lengthvector, 0x10);
-  return clprod1;
-}
-
-// modulo reduction to 64-bit value. The high 64 bits contain garbage, see
-// precompReduction64
-static inline __m128i precompReduction64_si128_port(__m128i A) {
-
-  // const __m128i C = _mm_set_epi64x(1U,(1U<<4)+(1U<<3)+(1U<<1)+(1U<<0)); // C
-  // is the irreducible poly. (64,4,3,1,0)
-  const __m128i C =
-      _mm_cvtsi64_si128_emu((1U << 4) + (1U << 3) + (1U << 1) + (1U << 0));
-  __m128i Q2 = _mm_clmulepi64_si128_emu(A, C, 0x01);
-  __m128i Q3 = _mm_shuffle_epi8_emu(
-      _mm_setr_epi8_emu(0, 27, 54, 45, 108, 119, 90, 65, (char)216, (char)195,
-                        (char)238, (char)245, (char)180, (char)175, (char)130,
-                        (char)153),
-      _mm_srli_si128_emu(Q2, 8));
-  __m128i Q4 = _mm_xor_si128_emu(Q2, A);
-  const __m128i final = _mm_xor_si128_emu(Q3, Q4);
-  return final; /// WARNING: HIGH 64 BITS SHOULD BE ASSUMED TO CONTAIN GARBAGE
-}
-
-static inline uint64_t precompReduction64_port(__m128i A) {
-  __m128i tmp = precompReduction64_si128_port(A);
-  return _mm_cvtsi128_si64_emu(tmp);
-}
-
-// verus intermediate hash extra
-__m128i __verusclmulwithoutreduction64alignedrepeat_port(
-    __m128i *randomsource, const __m128i buf[4], uint64_t keyMask,
-    __m128i **pMoveScratch) {
-  __m128i const *pbuf;
-
-  /*
-  std::cout << "Random key start: ";
-  std::cout << LEToHex(*randomsource) << ", ";
-  std::cout << LEToHex(*(randomsource + 1));
-  std::cout << std::endl;
-  */
-
-  // divide key mask by 16 from bytes to __m128i
-  keyMask >>= 4;
-
-  // the random buffer must have at least 32 16 byte dwords after the keymask to
-  // work with this algorithm. we take the value from the last element inside
-  // the keyMask + 2, as that will never be used to xor into the accumulator
-  // before it is hashed with other values first
-  __m128i acc = _mm_load_si128_emu(randomsource + (keyMask + 2));
-
-  for (int64_t i = 0; i < 32; i++) {
-    // std::cout << "LOOP " << i << " acc: " << LEToHex(acc) << std::endl;
-
-    const uint64_t selector = _mm_cvtsi128_si64_emu(acc);
-
-    // get two random locations in the key, which will be mutated and swapped
-    __m128i *prand = randomsource + ((selector >> 5) & keyMask);
-    __m128i *prandex = randomsource + ((selector >> 32) & keyMask);
-
-    *pMoveScratch++ = prand;
-    *pMoveScratch++ = prandex;
-
-    // select random start and order of pbuf processing
-    pbuf = buf + (selector & 3);
-
-    switch (selector & 0x1c) {
-    case 0: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      /*
-      std::cout << "temp1: " << LEToHex(temp1) << std::endl;
-      std::cout << "temp2: " << LEToHex(temp2) << std::endl;
-      std::cout << "add1: " << LEToHex(add1) << std::endl;
-      std::cout << "clprod1: " << LEToHex(clprod1) << std::endl;
-      std::cout << "acc: " << LEToHex(acc) << std::endl;
-      */
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 = _mm_load_si128_emu(pbuf);
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 4: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-      const __m128i clprod2 = _mm_clmulepi64_si128_emu(temp2, temp2, 0x10);
-      acc = _mm_xor_si128_emu(clprod2, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      acc = _mm_xor_si128_emu(add12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prand, tempb2);
-      break;
-    }
-    case 8: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-      const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-      acc = _mm_xor_si128_emu(clprod22, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 0xc: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-
-      // cannot be zero here
-      const int32_t divisor = (uint32_t)selector;
-
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const int64_t dividend = _mm_cvtsi128_si64_emu(acc);
-      const __m128i modulo = _mm_cvtsi32_si128_emu(dividend % divisor);
-      acc = _mm_xor_si128_emu(modulo, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      if (dividend & 1) {
-        const __m128i temp12 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-
-        const __m128i temp22 = _mm_load_si128_emu(pbuf);
-        const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-        const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-        acc = _mm_xor_si128_emu(clprod12, acc);
-        const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-        acc = _mm_xor_si128_emu(clprod22, acc);
-
-        const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-        const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-        _mm_store_si128_emu(prand, tempb2);
-      } else {
-        const __m128i tempb3 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-        _mm_store_si128_emu(prand, tempb3);
-      }
-      break;
-    }
-    case 0x10: {
-      // a few AES operations
-      const __m128i *rc = prand;
-      __m128i tmp;
-
-      __m128i temp1 = _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      __m128i temp2 = _mm_load_si128_emu(pbuf);
-
-      AES2_EMU(temp1, temp2, 0);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 4);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 8);
-      MIX2_EMU(temp1, temp2);
-
-      acc = _mm_xor_si128_emu(temp1, acc);
-      acc = _mm_xor_si128_emu(temp2, acc);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x14: {
-      // we'll just call this one the monkins loop, inspired by Chris
-      const __m128i *buftmp = pbuf - (((selector & 1) << 1) - 1);
-      __m128i tmp; // used by MIX2
-
-      uint64_t rounds = selector >> 61; // loop randomly between 1 and 8 times
-      __m128i *rc = prand;
-      uint64_t aesround = 0;
-      __m128i onekey;
-
-      do {
-        // std::cout << "acc: " << LEToHex(acc) << ", round check: " <<
-        // LEToHex((selector & (0x10000000 << rounds))) << std::endl;
-
-        // note that due to compiler and CPUs, we expect this to do:
-        // if (selector & ((0x10000000 << rounds) & 0xffffffff) if rounds != 3
-        // else selector & 0xffffffff80000000):
-        if (selector & (0x10000000 << rounds)) {
-          onekey = _mm_load_si128_emu(rc++);
-          const __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? pbuf : buftmp);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-          acc = _mm_xor_si128_emu(clprod1, acc);
-        } else {
-          onekey = _mm_load_si128_emu(rc++);
-          __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? buftmp : pbuf);
-          const uint64_t roundidx = aesround++ << 2;
-          AES2_EMU(onekey, temp2, roundidx);
-
-          /*
-          std::cout << " onekey1: " << LEToHex(onekey) << std::endl;
-          std::cout << "  temp21: " << LEToHex(temp2) << std::endl;
-          std::cout << "roundkey: " << LEToHex(rc[roundidx]) << std::endl;
-
-          aesenc((unsigned char *)&onekey, (unsigned char *)&(rc[roundidx]));
-
-          std::cout << "onekey2: " << LEToHex(onekey) << std::endl;
-          std::cout << "roundkey: " << LEToHex(rc[roundidx + 1]) << std::endl;
-
-          aesenc((unsigned char *)&temp2, (unsigned char *)&(rc[roundidx + 1]));
-
-          std::cout << " temp22: " << LEToHex(temp2) << std::endl;
-          std::cout << "roundkey: " << LEToHex(rc[roundidx + 2]) << std::endl;
-
-          aesenc((unsigned char *)&onekey, (unsigned char *)&(rc[roundidx +
-          2]));
-
-          std::cout << "onekey2: " << LEToHex(onekey) << std::endl;
-
-          aesenc((unsigned char *)&temp2, (unsigned char *)&(rc[roundidx + 3]));
-
-          std::cout << " temp22: " << LEToHex(temp2) << std::endl;
-          */
-
-          MIX2_EMU(onekey, temp2);
-
-          /*
-          std::cout << "onekey3: " << LEToHex(onekey) << std::endl;
-          */
-
-          acc = _mm_xor_si128_emu(onekey, acc);
-          acc = _mm_xor_si128_emu(temp2, acc);
-        }
-      } while (rounds--);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x18: {
-      const __m128i temp1 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i temp2 = _mm_load_si128_emu(prand);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp2);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp2);
-
-      const __m128i tempb3 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa2);
-      _mm_store_si128_emu(prand, tempb3);
-      break;
-    }
-    case 0x1c: {
-      const __m128i temp1 = _mm_load_si128_emu(pbuf);
-      const __m128i temp2 = _mm_load_si128_emu(prandex);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp2);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp2);
-
-      const __m128i tempa3 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      acc = _mm_xor_si128_emu(tempa3, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, tempa3);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, tempa3);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    }
-  }
-  return acc;
-}
-
-// verus intermediate hash extra
-__m128i __verusclmulwithoutreduction64alignedrepeat_sv2_1_port(
-    __m128i *randomsource, const __m128i buf[4], uint64_t keyMask,
-    __m128i **pMoveScratch) {
-  const __m128i pbuf_copy[4] = {_mm_xor_si128(buf[0], buf[2]),
-                                _mm_xor_si128(buf[1], buf[3]), buf[2], buf[3]};
-  const __m128i *pbuf;
-
-  // divide key mask by 16 from bytes to __m128i
-  keyMask >>= 4;
-
-  // the random buffer must have at least 32 16 byte dwords after the keymask to
-  // work with this algorithm. we take the value from the last element inside
-  // the keyMask + 2, as that will never be used to xor into the accumulator
-  // before it is hashed with other values first
-  __m128i acc = _mm_load_si128_emu(randomsource + (keyMask + 2));
-
-  for (int64_t i = 0; i < 32; i++) {
-    // std::cout << "LOOP " << i << " acc: " << LEToHex(acc) << std::endl;
-
-    const uint64_t selector = _mm_cvtsi128_si64_emu(acc);
-
-    // get two random locations in the key, which will be mutated and swapped
-    __m128i *prand = randomsource + ((selector >> 5) & keyMask);
-    __m128i *prandex = randomsource + ((selector >> 32) & keyMask);
-
-    *pMoveScratch++ = prand;
-    *pMoveScratch++ = prandex;
-
-    // select random start and order of pbuf processing
-    pbuf = pbuf_copy + (selector & 3);
-
-    switch (selector & 0x1c) {
-    case 0: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 = _mm_load_si128_emu(pbuf);
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 4: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-      const __m128i clprod2 = _mm_clmulepi64_si128_emu(temp2, temp2, 0x10);
-      acc = _mm_xor_si128_emu(clprod2, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      acc = _mm_xor_si128_emu(add12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prand, tempb2);
-      break;
-    }
-    case 8: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-      const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-      acc = _mm_xor_si128_emu(clprod22, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 0xc: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-
-      // cannot be zero here
-      const int32_t divisor = (uint32_t)selector;
-
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const int64_t dividend = _mm_cvtsi128_si64_emu(acc);
-      const __m128i modulo = _mm_cvtsi32_si128_emu(dividend % divisor);
-      acc = _mm_xor_si128_emu(modulo, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      if (dividend & 1) {
-        const __m128i temp12 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-
-        const __m128i temp22 = _mm_load_si128_emu(pbuf);
-        const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-        const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-        acc = _mm_xor_si128_emu(clprod12, acc);
-        const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-        acc = _mm_xor_si128_emu(clprod22, acc);
-
-        const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-        const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-        _mm_store_si128_emu(prand, tempb2);
-      } else {
-        const __m128i tempb3 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-        _mm_store_si128_emu(prand, tempb3);
-      }
-      break;
-    }
-    case 0x10: {
-      // a few AES operations
-      const __m128i *rc = prand;
-      __m128i tmp;
-
-      __m128i temp1 = _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      __m128i temp2 = _mm_load_si128_emu(pbuf);
-
-      AES2_EMU(temp1, temp2, 0);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 4);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 8);
-      MIX2_EMU(temp1, temp2);
-
-      acc = _mm_xor_si128_emu(temp1, acc);
-      acc = _mm_xor_si128_emu(temp2, acc);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x14: {
-      // we'll just call this one the monkins loop, inspired by Chris
-      const __m128i *buftmp = pbuf - (((selector & 1) << 1) - 1);
-      __m128i tmp; // used by MIX2
-
-      uint64_t rounds = selector >> 61; // loop randomly between 1 and 8 times
-      __m128i *rc = prand;
-      uint64_t aesround = 0;
-      __m128i onekey;
-
-      do {
-        // this is simplified over the original verus_clhash
-        if (selector & (((uint64_t)0x10000000) << rounds)) {
-          onekey = _mm_load_si128_emu(rc++);
-          const __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? pbuf : buftmp);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-          acc = _mm_xor_si128_emu(clprod1, acc);
-        } else {
-          onekey = _mm_load_si128_emu(rc++);
-          __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? buftmp : pbuf);
-          const uint64_t roundidx = aesround++ << 2;
-          AES2_EMU(onekey, temp2, roundidx);
-
-          MIX2_EMU(onekey, temp2);
-
-          acc = _mm_xor_si128_emu(onekey, acc);
-          acc = _mm_xor_si128_emu(temp2, acc);
-        }
-      } while (rounds--);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x18: {
-      const __m128i *buftmp = pbuf - (((selector & 1) << 1) - 1);
-
-      uint64_t rounds = selector >> 61; // loop randomly between 1 and 8 times
-      __m128i *rc = prand;
-      __m128i onekey;
-
-      do {
-        if (selector & (((uint64_t)0x10000000) << rounds)) {
-          onekey = _mm_load_si128_emu(rc++);
-          const __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? pbuf : buftmp);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          // cannot be zero here, may be negative
-          const int32_t divisor = (uint32_t)selector;
-          const int64_t dividend = _mm_cvtsi128_si64_emu(add1);
-          const __m128i modulo = _mm_cvtsi32_si128_emu(dividend % divisor);
-          acc = _mm_xor_si128_emu(modulo, acc);
-        } else {
-          onekey = _mm_load_si128_emu(rc++);
-          __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? buftmp : pbuf);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-          const __m128i clprod2 = _mm_mulhrs_epi16_emu(acc, clprod1);
-          acc = _mm_xor_si128_emu(clprod2, acc);
-        }
-      } while (rounds--);
-
-      const __m128i tempa3 = _mm_load_si128_emu(prandex);
-      const __m128i tempa4 = _mm_xor_si128_emu(tempa3, acc);
-      _mm_store_si128_emu(prandex, tempa4);
-      _mm_store_si128_emu(prand, onekey);
-      break;
-    }
-    case 0x1c: {
-      const __m128i temp1 = _mm_load_si128_emu(pbuf);
-      const __m128i temp2 = _mm_load_si128_emu(prandex);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp2);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp2);
-
-      const __m128i tempa3 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      acc = _mm_xor_si128_emu(tempa3, acc);
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, tempa3);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, tempa3);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    }
-  }
-  return acc;
-}
-
-// verus intermediate hash extra
-__m128i __verusclmulwithoutreduction64alignedrepeat_sv2_2_port(
-    __m128i *randomsource, const __m128i buf[4], uint64_t keyMask,
-    __m128i **pMoveScratch) {
-  const __m128i pbuf_copy[4] = {_mm_xor_si128(buf[0], buf[2]),
-                                _mm_xor_si128(buf[1], buf[3]), buf[2], buf[3]};
-  const __m128i *pbuf;
-
-  // divide key mask by 16 from bytes to __m128i
-  keyMask >>= 4;
-
-  // the random buffer must have at least 32 16 byte dwords after the keymask to
-  // work with this algorithm. we take the value from the last element inside
-  // the keyMask + 2, as that will never be used to xor into the accumulator
-  // before it is hashed with other values first
-  __m128i acc = _mm_load_si128_emu(randomsource + (keyMask + 2));
-
-  for (int64_t i = 0; i < 32; i++) {
-    // std::cout << "LOOP " << i << " acc: " << LEToHex(acc) << std::endl;
-
-    const uint64_t selector = _mm_cvtsi128_si64_emu(acc);
-
-    // get two random locations in the key, which will be mutated and swapped
-    __m128i *prand = randomsource + ((selector >> 5) & keyMask);
-    __m128i *prandex = randomsource + ((selector >> 32) & keyMask);
-
-    *pMoveScratch++ = prand;
-    *pMoveScratch++ = prandex;
-
-    // select random start and order of pbuf processing
-    pbuf = pbuf_copy + (selector & 3);
-
-    switch (selector & 0x1c) {
-    case 0: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 = _mm_load_si128_emu(pbuf);
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 4: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-      const __m128i clprod2 = _mm_clmulepi64_si128_emu(temp2, temp2, 0x10);
-      acc = _mm_xor_si128_emu(clprod2, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      acc = _mm_xor_si128_emu(add12, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prand, tempb2);
-      break;
-    }
-    case 8: {
-      const __m128i temp1 = _mm_load_si128_emu(prandex);
-      const __m128i temp2 = _mm_load_si128_emu(pbuf);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      const __m128i temp12 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      const __m128i temp22 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-      const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-      acc = _mm_xor_si128_emu(clprod12, acc);
-      const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-      acc = _mm_xor_si128_emu(clprod22, acc);
-
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    case 0xc: {
-      const __m128i temp1 = _mm_load_si128_emu(prand);
-      const __m128i temp2 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-
-      // cannot be zero here
-      const int32_t divisor = (uint32_t)selector;
-
-      acc = _mm_xor_si128_emu(add1, acc);
-
-      const int64_t dividend = _mm_cvtsi128_si64_emu(acc);
-      const __m128i modulo = _mm_cvtsi32_si128_emu(dividend % divisor);
-      acc = _mm_xor_si128_emu(modulo, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp1);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp1);
-
-      if (dividend & 1) {
-        const __m128i temp12 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-
-        const __m128i temp22 = _mm_load_si128_emu(pbuf);
-        const __m128i add12 = _mm_xor_si128_emu(temp12, temp22);
-        const __m128i clprod12 = _mm_clmulepi64_si128_emu(add12, add12, 0x10);
-        acc = _mm_xor_si128_emu(clprod12, acc);
-        const __m128i clprod22 = _mm_clmulepi64_si128_emu(temp22, temp22, 0x10);
-        acc = _mm_xor_si128_emu(clprod22, acc);
-
-        const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, temp12);
-        const __m128i tempb2 = _mm_xor_si128_emu(tempb1, temp12);
-        _mm_store_si128_emu(prand, tempb2);
-      } else {
-        const __m128i tempb3 = _mm_load_si128_emu(prandex);
-        _mm_store_si128_emu(prandex, tempa2);
-        _mm_store_si128_emu(prand, tempb3);
-        const __m128i tempb4 = _mm_load_si128_emu(pbuf);
-        acc = _mm_xor_si128_emu(tempb4, acc);
-      }
-      break;
-    }
-    case 0x10: {
-      // a few AES operations
-      const __m128i *rc = prand;
-      __m128i tmp;
-
-      __m128i temp1 = _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      __m128i temp2 = _mm_load_si128_emu(pbuf);
-
-      AES2_EMU(temp1, temp2, 0);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 4);
-      MIX2_EMU(temp1, temp2);
-
-      AES2_EMU(temp1, temp2, 8);
-      MIX2_EMU(temp1, temp2);
-
-      acc = _mm_xor_si128_emu(temp1, acc);
-      acc = _mm_xor_si128_emu(temp2, acc);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x14: {
-      // we'll just call this one the monkins loop, inspired by Chris
-      const __m128i *buftmp = pbuf - (((selector & 1) << 1) - 1);
-      __m128i tmp; // used by MIX2
-
-      uint64_t rounds = selector >> 61; // loop randomly between 1 and 8 times
-      __m128i *rc = prand;
-      uint64_t aesround = 0;
-      __m128i onekey;
-
-      do {
-        // this is simplified over the original verus_clhash
-        if (selector & (((uint64_t)0x10000000) << rounds)) {
-          onekey = _mm_load_si128_emu(rc++);
-          const __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? pbuf : buftmp);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-          acc = _mm_xor_si128_emu(clprod1, acc);
-        } else {
-          onekey = _mm_load_si128_emu(rc++);
-          __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? buftmp : pbuf);
-          const uint64_t roundidx = aesround++ << 2;
-          AES2_EMU(onekey, temp2, roundidx);
-
-          MIX2_EMU(onekey, temp2);
-
-          acc = _mm_xor_si128_emu(onekey, acc);
-          acc = _mm_xor_si128_emu(temp2, acc);
-        }
-      } while (rounds--);
-
-      const __m128i tempa1 = _mm_load_si128_emu(prand);
-      const __m128i tempa2 = _mm_mulhrs_epi16_emu(acc, tempa1);
-      const __m128i tempa3 = _mm_xor_si128_emu(tempa1, tempa2);
-
-      const __m128i tempa4 = _mm_load_si128_emu(prandex);
-      _mm_store_si128_emu(prandex, tempa3);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x18: {
-      const __m128i *buftmp = pbuf - (((selector & 1) << 1) - 1);
-
-      uint64_t rounds = selector >> 61; // loop randomly between 1 and 8 times
-      __m128i *rc = prand;
-      __m128i onekey;
-
-      do {
-        if (selector & (((uint64_t)0x10000000) << rounds)) {
-          onekey = _mm_load_si128_emu(rc++);
-          const __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? pbuf : buftmp);
-          onekey = _mm_xor_si128_emu(onekey, temp2);
-          // cannot be zero here, may be negative
-          const int32_t divisor = (uint32_t)selector;
-          const int64_t dividend = _mm_cvtsi128_si64_emu(onekey);
-          const __m128i modulo = _mm_cvtsi32_si128_emu(dividend % divisor);
-          acc = _mm_xor_si128_emu(modulo, acc);
-        } else {
-          onekey = _mm_load_si128_emu(rc++);
-          __m128i temp2 = _mm_load_si128_emu(rounds & 1 ? buftmp : pbuf);
-          const __m128i add1 = _mm_xor_si128_emu(onekey, temp2);
-          onekey = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-          const __m128i clprod2 = _mm_mulhrs_epi16_emu(acc, onekey);
-          acc = _mm_xor_si128_emu(clprod2, acc);
-        }
-      } while (rounds--);
-
-      const __m128i tempa3 = _mm_load_si128_emu(prandex);
-      const __m128i tempa4 = _mm_xor_si128_emu(tempa3, acc);
-      _mm_store_si128_emu(prandex, onekey);
-      _mm_store_si128_emu(prand, tempa4);
-      break;
-    }
-    case 0x1c: {
-      const __m128i temp1 = _mm_load_si128_emu(pbuf);
-      const __m128i temp2 = _mm_load_si128_emu(prandex);
-      const __m128i add1 = _mm_xor_si128_emu(temp1, temp2);
-      const __m128i clprod1 = _mm_clmulepi64_si128_emu(add1, add1, 0x10);
-      acc = _mm_xor_si128_emu(clprod1, acc);
-
-      const __m128i tempa1 = _mm_mulhrs_epi16_emu(acc, temp2);
-      const __m128i tempa2 = _mm_xor_si128_emu(tempa1, temp2);
-
-      const __m128i tempa3 = _mm_load_si128_emu(prand);
-      _mm_store_si128_emu(prand, tempa2);
-
-      acc = _mm_xor_si128_emu(tempa3, acc);
-      const __m128i temp4 =
-          _mm_load_si128_emu(pbuf - (((selector & 1) << 1) - 1));
-      acc = _mm_xor_si128_emu(temp4, acc);
-      const __m128i tempb1 = _mm_mulhrs_epi16_emu(acc, tempa3);
-      const __m128i tempb2 = _mm_xor_si128_emu(tempb1, tempa3);
-      _mm_store_si128_emu(prandex, tempb2);
-      break;
-    }
-    }
-  }
-  return acc;
-}
-
-// hashes 64 bytes only by doing a carryless multiplication and reduction of the
-// repeated 64 byte sequence 16 times, returning a 64 bit hash value
-uint64_t verusclhash_port(void *random, const unsigned char buf[64],
-                          uint64_t keyMask, __m128i **pMoveScratch) {
-  __m128i *rs64 = (__m128i *)random;
-  const __m128i *string = (const __m128i *)buf;
-
-  __m128i acc = __verusclmulwithoutreduction64alignedrepeat_port(
-      rs64, string, keyMask, pMoveScratch);
-  acc = _mm_xor_si128_emu(acc, lazyLengthHash_port(1024, 64));
-  return precompReduction64_port(acc);
-}
-
-// hashes 64 bytes only by doing a carryless multiplication and reduction of the
-// repeated 64 byte sequence 16 times, returning a 64 bit hash value
-uint64_t verusclhash_sv2_1_port(void *random, const unsigned char buf[64],
-                                uint64_t keyMask, __m128i **pMoveScratch) {
-  __m128i *rs64 = (__m128i *)random;
-  const __m128i *string = (const __m128i *)buf;
-
-  __m128i acc = __verusclmulwithoutreduction64alignedrepeat_sv2_1_port(
-      rs64, string, keyMask, pMoveScratch);
-  acc = _mm_xor_si128_emu(acc, lazyLengthHash_port(1024, 64));
-  return precompReduction64_port(acc);
-}
-
-uint64_t verusclhash_sv2_2_port(void *random, const unsigned char buf[64],
-                                uint64_t keyMask, __m128i **pMoveScratch) {
-  __m128i *rs64 = (__m128i *)random;
-  const __m128i *string = (const __m128i *)buf;
-
-  __m128i acc = __verusclmulwithoutreduction64alignedrepeat_sv2_2_port(
-      rs64, string, keyMask, pMoveScratch);
-  acc = _mm_xor_si128_emu(acc, lazyLengthHash_port(1024, 64));
-  return precompReduction64_port(acc);
-}
 
+#define VERUS_IMPL(name) name##_port
+#include "verus_clhash_impl.hpp"
@@ -1,18 +1,4 @@
-#ifdef _WIN32
-#undef __cpuid
-#include <intrin.h>
-#endif
-
-#if defined(__arm__) || defined(__aarch64__)
-#include "crypto/sse2neon.h"
-// #include <asm/hwcap.h>
-// #include <sys/auxv.h>
-#else
-#include <cpuid.h>
-#include <x86intrin.h>
-#endif // !WIN32
-
-// #include "verus_clhash_opt.hpp"
+#include "verus_clhash_opt.hpp"
 #include "verus_clhash_port.hpp"
 
 namespace Verus {
@@ -68,28 +54,29 @@ private:
     /* data */
     alignas(32) uint8_t key[2 * keySizeInBytes];
 };
-bool can_optimize()
+namespace {
+// selected once, the hardware versions produce identical results
+struct Implementation {
+    void (*haraka512)(unsigned char* out, const unsigned char* in);
+    void (*haraka512_keyed)(unsigned char* out, const unsigned char* in, const u128* rc);
+    void (*haraka256)(unsigned char* out, const unsigned char* in);
+    HashKey::VerusHashFunctionType verusclhash_v2_1;
+    HashKey::VerusHashFunctionType verusclhash_v2_2;
+};
+const Implementation& impl()
 {
-#if defined(__arm__) || defined(__aarch64__)
-    // long hwcaps = getauxval(AT_HWCAP);
-    //
-    // if ((hwcaps & HWCAP_AES) && (hwcaps & HWCAP_PMULL))
-    //     return true;
-    // else
-    return false;
-#else
-    unsigned int eax, ebx, ecx, edx;
-    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
-        return false;
-    } else {
-        return ((ecx & (bit_AVX | bit_AES | bit_PCLMUL)) == (bit_AVX | bit_AES | bit_PCLMUL));
-    }
-#endif
+    static const Implementation i { can_optimize()
+            ? Implementation { haraka512_opt, haraka512_opt_keyed, haraka256_opt,
+                verusclhash_sv2_1_opt, verusclhash_sv2_2_opt }
+            : Implementation { haraka512_port, haraka512_port_keyed, haraka256_port,
+                verusclhash_sv2_1_port, verusclhash_sv2_2_port } };
+    return i;
+}
 }
 
-VerusHasher::VerusHasher()
+bool can_optimize()
 {
-    optimized = can_optimize();
+    return verus_opt_supported();
 }
 
 template <typename T>
@@ -105,25 +92,6 @@ void VerusHasher::FillExtra(const T* _data)
         left -= len;
     } while (left > 0);
 }
-// void VerusHasher::haraka512KeyedFunction(unsigned char* out,
-//     const unsigned char* in,
-//     const u128* rc)
-// {
-//     if (optimized)
-//         return haraka512_keyed(out, in, rc);
-//     return haraka512_port_keyed(out, in, rc);
-// };
-// uint64_t VerusHasher::verusclhashfunction(void* random,
-//     const unsigned char buf[64],
-//     uint64_t keyMask,
-//     __m128i** pMoveScratch)
-// {
-//
-//     if (optimized)
-//         return verusclhash_sv2_1(random, buf, keyMask, pMoveScratch);
-//     return verusclhash_sv2_1_port(random, buf, keyMask, pMoveScratch);
-// };
-
 void HashKey::update_seed(HashView newSeed,
     void (*haraka256Function)(unsigned char* out,
         const unsigned char* in))
@@ -172,11 +140,11 @@ Hash VerusHasher::finalize(bool useV2_2)
 
     // gen new key with what is last in buffer
 
-    HashKey hk(curBuf, haraka256_port);
+    HashKey hk(curBuf, impl().haraka256);
 
     // run verusclhash on the buffer
     uint64_t intermediate { hk.apply_verusclhash(
-        curBuf, useV2_2 ? verusclhash_sv2_2_port : verusclhash_sv2_1_port) };
+        curBuf, useV2_2 ? impl().verusclhash_v2_2 : impl().verusclhash_v2_1) };
     // fill buffer to the end with the result
     FillExtra(&intermediate);
 
@@ -184,7 +152,7 @@ Hash VerusHasher::finalize(bool useV2_2)
     Hash out;
     constexpr uint64_t mask16 = keyMask >> 4;
 
-    haraka512_port_keyed(out.data(), curBuf,
+    impl().haraka512_keyed(out.data(), curBuf,
         (const u128*)hk.key_data() + (intermediate & mask16));
 
     return out;
@@ -192,7 +160,7 @@ Hash VerusHasher::finalize(bool useV2_2)
 
 VerusHasher& VerusHasher::write(const uint8_t* data, size_t len)
 {
-    return write(data, len, haraka512_port);
+    return write(data, len, impl().haraka512);
 };
 
 } // namespace Verus
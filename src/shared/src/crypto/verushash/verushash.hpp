@@ -14,7 +14,18 @@ class VerusHasher {
     friend class MinerPort;
 
 public:
-    VerusHasher();
+    VerusHasher() = default;
+    VerusHasher(const VerusHasher& other) { *this = other; }
+    VerusHasher& operator=(const VerusHasher& other)
+    {
+        // buffer pointers must refer to our own buffers
+        std::memcpy(buf1, other.buf1, 64);
+        std::memcpy(buf2, other.buf2, 64);
+        curBuf = other.curBuf == other.buf1 ? buf1 : buf2;
+        result = curBuf == buf1 ? buf2 : buf1;
+        curPos = other.curPos;
+        return *this;
+    }
     void reset()
     {
         std::memset(curBuf, 0, 64);
@@ -51,11 +62,10 @@ private:
         }
         return *this;
     }
-    alignas(32) unsigned char buf1[64] = { 0 }, buf2[64];
+    alignas(32) unsigned char buf1[64] = { 0 }, buf2[64] = { 0 };
     unsigned char *curBuf = buf1, *result = buf2;
     size_t curPos = 0;
     // Hash hasher_seed;
-    bool optimized { false };
 
     // methods
     template <typename T>
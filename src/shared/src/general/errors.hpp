@@ -109,12 +109,14 @@
     XX(206, ENOTSYNCED, "node not synced yet")                          \
     XX(207, ECONNRATELIMIT, "connection rate limit exceeded")           \
     XX(208, EFROZENACC, "account is frozen and can't send")             \
+    XX(209, ENOBALANCEINDEX, "balance index not available")             \
     XX(1000, ESIGTERM, "received SIGTERM")                              \
     XX(1001, ESIGHUP, "received SIGHUP")                                \
     XX(1002, ESIGINT, "received SIGINT")                                \
     XX(1003, EREFUSED, "connection refused due to ban")                 \
     XX(1004, EMAXCONNECTIONS, "too many connections from this ip")      \
     XX(1005, EDUPLICATECONNECTION, "duplicate connection")              \
+    XX(1006, EREPLAYEND, "traffic replay finished")                     \
     XX(2000, EBUG, "bug-related error")
 
 #define ERR_DEFINE(code, name, _) constexpr int32_t name = code;
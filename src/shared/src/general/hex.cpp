@@ -1,18 +1,217 @@
 #include "hex.hpp"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HEX_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HEX_NEON
+#endif
+
+namespace {
+constexpr const char* digits = "0123456789abcdef";
+
+// nibble value of a hex character or 0xff
+constexpr auto make_decode_table()
+{
+    std::array<uint8_t, 256> t {};
+    for (auto& e : t)
+        e = 0xff;
+    for (uint8_t i = 0; i < 10; ++i)
+        t['0' + i] = i;
+    for (uint8_t i = 0; i < 6; ++i) {
+        t['a' + i] = 10 + i;
+        t['A' + i] = 10 + i;
+    }
+    return t;
+}
+constexpr auto decodeTable { make_decode_table() };
+
+enum class Acceleration {
+    None = 0, // zero before dynamic initialization
+    SSSE3,
+    AVX2,
+    NEON
+};
+
+#ifdef HEX_X86
+__attribute__((target("ssse3"))) size_t encode_ssse3(const uint8_t* data, size_t size, char* out)
+{
+    const __m128i lut { _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)) };
+    const __m128i mask { _mm_set1_epi8(0x0f) };
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v { _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)) };
+        __m128i hi { _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask)) };
+        __m128i lo { _mm_shuffle_epi8(lut, _mm_and_si128(v, mask)) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t encode_avx2(const uint8_t* data, size_t size, char* out)
+{
+    const __m256i lut { _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits))) };
+    const __m256i mask { _mm256_set1_epi8(0x0f) };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)) };
+        __m256i hi { _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask)) };
+        __m256i lo { _mm256_shuffle_epi8(lut, _mm256_and_si256(v, mask)) };
+        // unpack works per 128 bit lane, restore byte order
+        __m256i a { _mm256_unpacklo_epi8(hi, lo) };
+        __m256i b { _mm256_unpackhi_epi8(hi, lo) };
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+// nibble values of 16 hex characters, clears valid on invalid input
+__attribute__((target("ssse3"))) inline __m128i nibbles_ssse3(__m128i c, __m128i& valid)
+{
+    __m128i d { _mm_sub_epi8(c, _mm_set1_epi8('0')) };
+    __m128i a { _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a')) };
+    __m128i isDigit { _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d) };
+    __m128i isAlpha { _mm_cmpeq_epi8(_mm_min_epu8(a, _mm_set1_epi8(5)), a) };
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isAlpha));
+    return _mm_or_si128(_mm_and_si128(isDigit, d),
+        _mm_and_si128(isAlpha, _mm_add_epi8(a, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3"))) size_t decode_ssse3(const char* in, size_t size, uint8_t* out, bool& ok)
+{
+    const __m128i weights { _mm_set1_epi16(0x0110) }; // high nibble * 16 + low nibble
+    __m128i valid { _mm_set1_epi8(-1) };
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i n0 { nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), valid) };
+        __m128i n1 { nibbles_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)), valid) };
+        __m128i b { _mm_packus_epi16(_mm_maddubs_epi16(n0, weights), _mm_maddubs_epi16(n1, weights)) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), b);
+    }
+    ok = _mm_movemask_epi8(valid) == 0xffff;
+    return i;
+}
+
+__attribute__((target("avx2"))) inline __m256i nibbles_avx2(__m256i c, __m256i& valid)
+{
+    __m256i d { _mm256_sub_epi8(c, _mm256_set1_epi8('0')) };
+    __m256i a { _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a')) };
+    __m256i isDigit { _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d) };
+    __m256i isAlpha { _mm256_cmpeq_epi8(_mm256_min_epu8(a, _mm256_set1_epi8(5)), a) };
+    valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isAlpha));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, d),
+        _mm256_and_si256(isAlpha, _mm256_add_epi8(a, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2"))) size_t decode_avx2(const char* in, size_t size, uint8_t* out, bool& ok)
+{
+    const __m256i weights { _mm256_set1_epi16(0x0110) };
+    __m256i valid { _mm256_set1_epi8(-1) };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i n0 { nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)), valid) };
+        __m256i n1 { nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)), valid) };
+        // pack works per 128 bit lane, restore byte order
+        __m256i b { _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weights), _mm256_maddubs_epi16(n1, weights)) };
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(b, 0xd8));
+    }
+    ok = uint32_t(_mm256_movemask_epi8(valid)) == 0xffffffff;
+    return i;
+}
+
+Acceleration detect()
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Acceleration::AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return Acceleration::SSSE3;
+    return Acceleration::None;
+}
+#elif defined(HEX_NEON)
+size_t encode_neon(const uint8_t* data, size_t size, char* out)
+{
+    const uint8x16_t lut { vld1q_u8(reinterpret_cast<const uint8_t*>(digits)) };
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v { vld1q_u8(data + i) };
+        uint8x16x2_t r;
+        r.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(v, 4));
+        r.val[1] = vqtbl1q_u8(lut, vandq_u8(v, vdupq_n_u8(0x0f)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), r); // interleaves
+    }
+    return i;
+}
+
+inline uint8x16_t nibbles_neon(uint8x16_t c, uint8x16_t& valid)
+{
+    uint8x16_t d { vsubq_u8(c, vdupq_n_u8('0')) };
+    uint8x16_t a { vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a')) };
+    uint8x16_t isDigit { vcleq_u8(d, vdupq_n_u8(9)) };
+    uint8x16_t isAlpha { vcleq_u8(a, vdupq_n_u8(5)) };
+    valid = vandq_u8(valid, vorrq_u8(isDigit, isAlpha));
+    return vbslq_u8(isDigit, d, vaddq_u8(a, vdupq_n_u8(10)));
+}
+
+size_t decode_neon(const char* in, size_t size, uint8_t* out, bool& ok)
+{
+    uint8x16_t valid { vdupq_n_u8(0xff) };
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16x2_t c { vld2q_u8(reinterpret_cast<const uint8_t*>(in + 2 * i)) }; // deinterleaves
+        uint8x16_t hi { nibbles_neon(c.val[0], valid) };
+        uint8x16_t lo { nibbles_neon(c.val[1], valid) };
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    ok = vminvq_u8(valid) == 0xff;
+    return i;
+}
+
+Acceleration detect() { return Acceleration::NEON; }
+#else
+Acceleration detect() { return Acceleration::None; }
+#endif
+
+const Acceleration acceleration { detect() };
+} // namespace
+
 void serialize_hex(uint32_t number, char* out)
 {
     uint32_t tmp = hton32(number);
     serialize_hex((const uint8_t*)&tmp, 4, out);
 };
 
-void serialize_hex(const uint8_t* data, size_t size, char* out)
+void serialize_hex_portable(const uint8_t* data, size_t size, char* out)
 {
-    constexpr const char* h = "0123456789abcdef";
     for (size_t i = 0; i < size; ++i) {
-        out[2 * i] = h[data[i] >> 4];
-        out[2 * i + 1] = h[data[i] & 15];
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 15];
+    }
+}
+
+void serialize_hex(const uint8_t* data, size_t size, char* out)
+{
+    size_t i = 0;
+    switch (acceleration) {
+#ifdef HEX_X86
+    case Acceleration::AVX2:
+        i = encode_avx2(data, size, out);
+        [[fallthrough]];
+    case Acceleration::SSSE3:
+        i += encode_ssse3(data + i, size - i, out + 2 * i);
+        break;
+#elif defined(HEX_NEON)
+    case Acceleration::NEON:
+        i = encode_neon(data, size, out);
+        break;
+#endif
+    default:
+        break;
     }
+    serialize_hex_portable(data + i, size - i, out + 2 * i);
 }
 
 std::string serialize_hex(const uint8_t* data, size_t size)
@@ -23,69 +222,57 @@ std::string serialize_hex(const uint8_t* data, size_t size)
     return out;
 }
 
-namespace {
-inline uint8_t hexdigit(char c, bool& valid)
-{
-    switch (c) {
-    case '0':
-        return 0;
-    case '1':
-        return 1;
-    case '2':
-        return 2;
-    case '3':
-        return 3;
-    case '4':
-        return 4;
-    case '5':
-        return 5;
-    case '6':
-        return 6;
-    case '7':
-        return 7;
-    case '8':
-        return 8;
-    case '9':
-        return 9;
-    case 'a':
-        return 10;
-    case 'b':
-        return 11;
-    case 'c':
-        return 12;
-    case 'd':
-        return 13;
-    case 'e':
-        return 14;
-    case 'f':
-        return 15;
-    case 'A':
-        return 10;
-    case 'B':
-        return 11;
-    case 'C':
-        return 12;
-    case 'D':
-        return 13;
-    case 'E':
-        return 14;
-    case 'F':
-        return 15;
-    default:
-        valid = false;
-        return 0;
+bool parse_hex_portable(std::string_view in, uint8_t* out, size_t out_size)
+{
+    if (in.size() != out_size * 2)
+        return false;
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < out_size; ++i) {
+        uint8_t hi = decodeTable[uint8_t(in[2 * i])];
+        uint8_t lo = decodeTable[uint8_t(in[2 * i + 1])];
+        invalid |= hi | lo;
+        out[i] = (hi << 4) | lo;
     }
-}
+    return (invalid & 0xf0) == 0;
 }
 
 bool parse_hex(std::string_view in, uint8_t* out, size_t out_size)
 {
     if (in.size() != out_size * 2)
         return false;
-    bool valid = true;
-    for (size_t i = 0; i < out_size && valid; ++i) {
-        out[i] = (hexdigit(in[2 * i], valid) << 4)
-            + (hexdigit(in[2 * i + 1], valid));
+    size_t i = 0;
+    bool ok = true;
+    switch (acceleration) {
+#ifdef HEX_X86
+    case Acceleration::AVX2:
+        i = decode_avx2(in.data(), out_size, out, ok);
+        if (!ok)
+            return false;
+        [[fallthrough]];
+    case Acceleration::SSSE3:
+        i += decode_ssse3(in.data() + 2 * i, out_size - i, out + i, ok);
+        break;
+#elif defined(HEX_NEON)
+    case Acceleration::NEON:
+        i = decode_neon(in.data(), out_size, out, ok);
+        break;
+#endif
+    default:
+        break;
+    }
+    return ok && parse_hex_portable(in.substr(2 * i), out + i, out_size - i);
+}
+
+const char* hex_acceleration()
+{
+    switch (acceleration) {
+    case Acceleration::SSSE3:
+        return "SSSE3";
+    case Acceleration::AVX2:
+        return "AVX2";
+    case Acceleration::NEON:
+        return "NEON";
+    default:
+        return "none";
     }
-    return valid;
 }
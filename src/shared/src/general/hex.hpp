@@ -6,8 +6,11 @@
 #include <string>
 #include <vector>
 
+// Encoding and decoding use AVX2, SSSE3 or NEON when available (detected
+// once), otherwise the portable versions below.
 void serialize_hex(uint32_t number, char* out);
 void serialize_hex(const uint8_t* data, size_t size, char* out);
+void serialize_hex_portable(const uint8_t* data, size_t size, char* out);
 std::string serialize_hex(const uint8_t* data, size_t size);
 
 template <size_t N>
@@ -34,6 +37,8 @@ inline std::string serialize_hex(uint32_t v)
 }
 
 bool parse_hex(std::string_view in, uint8_t* out, size_t out_size);
+bool parse_hex_portable(std::string_view in, uint8_t* out, size_t out_size);
+[[nodiscard]] const char* hex_acceleration();
 inline void parse_hex_throw(std::string_view in, uint8_t* out, size_t out_size)
 {
     if(!parse_hex(in, out, out_size))
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <vector>
 #include "general/view.hpp"
 #include "general/byte_order.hpp"
@@ -19,6 +20,11 @@ struct Range {
         , len(bytes.size())
     {
     }
+    Range(std::span<const uint8_t> bytes)
+        : pos(bytes.data())
+        , len(bytes.size())
+    {
+    }
     template <size_t N>
     Range(const std::array<uint8_t, N>& bytes)
         : pos(bytes.data())
@@ -0,0 +1,140 @@
+#include "eventloop/address_manager/address_book.hpp"
+#include <cassert>
+#include <iostream>
+#include <set>
+using namespace std;
+using address_manager::AddressBook;
+using address_manager::FailedAddresses;
+
+EndpointAddress address(uint32_t group, uint32_t i)
+{
+    return { IPv4((group << 16) | (i & 0xffff)), uint16_t(9186 + (i >> 16)) };
+}
+
+// address book contents match the model exactly
+void check(const AddressBook& b, const set<EndpointAddress>& model)
+{
+    assert(b.size() == model.size());
+    set<EndpointAddress> data(b.data().begin(), b.data().end());
+    assert(data == model);
+    for (auto& a : model)
+        assert(b.contains(a));
+}
+
+// Inserts and erases randomly, on slot collision exactly the previous
+// occupant must be evicted. This also exercises the swap-remove in erase.
+void test_model()
+{
+    AddressBook b;
+    set<EndpointAddress> model;
+    mt19937 rng(1);
+    size_t evictions { 0 };
+    for (size_t i = 0; i < 8000; ++i) {
+        auto a { address(rng() % 64, rng() % 2000) };
+        if (rng() % 4 == 0) {
+            b.erase(a);
+            model.erase(a);
+        } else {
+            const bool fresh { !model.contains(a) };
+            assert(b.insert(a, IPv4(uint32_t(rng() % 32) << 16)) == fresh);
+            if (fresh) {
+                model.insert(a);
+                if (b.size() < model.size()) { // collision
+                    evictions += 1;
+                    size_t missing { 0 };
+                    for (auto iter { model.begin() }; iter != model.end();) {
+                        if (!b.contains(*iter)) {
+                            iter = model.erase(iter);
+                            missing += 1;
+                        } else
+                            ++iter;
+                    }
+                    assert(missing == 1);
+                }
+            }
+        }
+        if (i % 499 == 0)
+            check(b, model);
+    }
+    check(b, model);
+    assert(evictions > 0);
+}
+
+// one source group reaches at most bucketsPerSourceGroup buckets
+void test_source_group_bound()
+{
+    AddressBook b;
+    for (uint32_t i = 0; i < 200000; ++i)
+        (void)b.insert(address(i % 60000, i), IPv4(0x0a000001));
+    assert(b.size() <= AddressBook::bucketsPerSourceGroup * AddressBook::bucketSize);
+    assert(b.size() > AddressBook::bucketSize); // not all in one bucket
+
+    // other sources still have room
+    size_t before { b.size() };
+    for (uint32_t i = 0; i < 1000; ++i)
+        (void)b.insert(address(i, i), IPv4((i % 256) << 16));
+    assert(b.size() > before + 500);
+}
+
+void test_pop_and_sample()
+{
+    AddressBook b;
+    for (uint32_t i = 0; i < 500; ++i)
+        (void)b.insert(address(i, i));
+    set<EndpointAddress> model(b.data().begin(), b.data().end());
+    check(b, model);
+    for (size_t n : { 0ul, 1ul, 20ul, 300ul, 5000ul }) {
+        auto s { b.sample(n) };
+        assert(s.size() == min(n, b.size()));
+        set<EndpointAddress> distinct(s.begin(), s.end());
+        assert(distinct.size() == s.size());
+        for (auto& a : s)
+            assert(model.contains(a));
+    }
+    while (auto a { b.pop_random() }) {
+        assert(model.erase(*a) == 1);
+        assert(!b.contains(*a));
+    }
+    assert(model.empty() && b.empty());
+}
+
+// a failed address is skipped until its entry expires, then it is
+// connectable again
+void test_failed_expiry()
+{
+    using namespace std::chrono;
+    FailedAddresses f(60min);
+    auto t { steady_clock::now() };
+    auto a { address(1, 1) }, b { address(2, 2) };
+    f.insert(a, t);
+    f.insert(b, t);
+    assert(f.contains(a, t + 59min));
+    assert(!f.contains(address(3, 3), t));
+
+    // failing again restarts the expiry time
+    f.insert(b, t + 30min);
+    assert(!f.contains(a, t + 60min));
+    assert(!f.contains(a, t)); // expired entries are erased
+    assert(f.contains(b, t + 60min));
+    assert(!f.contains(b, t + 90min));
+    assert(f.size() == 0);
+
+    f.insert(a, t);
+    f.erase(a);
+    assert(!f.contains(a, t));
+
+    // bounded like the address book
+    for (uint32_t i = 0; i < 3 * AddressBook::capacity; ++i)
+        f.insert(address(i % 4096, i), t);
+    assert(f.size() <= AddressBook::capacity);
+}
+
+int main()
+{
+    test_model();
+    test_source_group_bound();
+    test_pop_and_sample();
+    test_failed_expiry();
+    cout << "AddressBook tests passed" << endl;
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "eventloop/address_manager/address_book.hpp"
+#include <chrono>
+#include <iostream>
+using namespace std;
+using namespace std::chrono;
+using address_manager::AddressBook;
+
+template <typename F>
+void measure(const char* name, F f)
+{
+    auto t { steady_clock::now() };
+    size_t n { f() };
+    auto ms { duration<double, milli>(steady_clock::now() - t).count() };
+    cout << name << ": " << ms << " ms (" << n << ")" << endl;
+}
+
+int main()
+{
+    constexpr uint32_t N { 100000 };
+    vector<EndpointAddress> addresses;
+    mt19937 rng(1);
+    for (uint32_t i = 0; i < N; ++i)
+        addresses.push_back({ IPv4(uint32_t(rng())), uint16_t(rng()) });
+
+    AddressBook b;
+    measure("insert 100k", [&]() {
+        size_t n { 0 };
+        for (auto& a : addresses)
+            n += b.insert(a, IPv4(uint32_t(rng())));
+        return n;
+    });
+    measure("lookup 100k", [&]() {
+        size_t n { 0 };
+        for (auto& a : addresses)
+            n += b.contains(a);
+        return n;
+    });
+    measure("sample 20, 100k times", [&]() {
+        size_t n { 0 };
+        for (uint32_t i = 0; i < N; ++i)
+            n += b.sample(20).size();
+        return n;
+    });
+    measure("erase 100k", [&]() {
+        for (auto& a : addresses)
+            b.erase(a);
+        return b.size();
+    });
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "api/http/chain_delta_feed.hpp"
+#include <cassert>
+#include <iostream>
+using namespace std;
+
+// hash of block at height h on fork f
+Hash block_hash(uint32_t h, uint8_t f = 0)
+{
+    Hash x {};
+    x[0] = uint8_t(h);
+    x[1] = uint8_t(h >> 8);
+    x[2] = f;
+    return x;
+}
+
+void push_blocks(ChainDeltaFeed& feed, uint32_t begin, uint32_t end, uint8_t f = 0)
+{
+    for (uint32_t h = begin; h < end; ++h)
+        feed.push_block(NonzeroHeight(h), block_hash(h, f), "block " + to_string(h));
+}
+
+void test_resume()
+{
+    ChainDeltaFeed feed;
+    assert(!feed.resume(Height(0), {})); // tip unknown
+    feed.set_tip(Height(0), {});
+    push_blocks(feed, 1, 11);
+    assert(feed.begin_seq() == 0 && feed.end_seq() == 10);
+    assert(feed.get(3) == "block 4");
+
+    assert(feed.resume(Height(0), {}) == 0u);
+    assert(feed.resume(Height(4), block_hash(4)) == 4u);
+    assert(feed.resume(Height(10), block_hash(10)) == 10u);
+    assert(!feed.resume(Height(4), block_hash(4, 1))); // different chain
+    assert(!feed.resume(Height(11), block_hash(11))); // ahead of us
+
+    // client on the abandoned fork continues after the rollback
+    feed.push_rollback(Height(7), "rollback 7");
+    push_blocks(feed, 8, 12, 1);
+    assert(feed.resume(Height(9), block_hash(9)) == 9u);
+    assert(feed.get(10) == "rollback 7");
+    assert(feed.resume(Height(9), block_hash(9, 1)) == 13u);
+    assert(feed.resume(Height(7), block_hash(7)) == 10u + 1);
+}
+
+void test_eviction()
+{
+    ChainDeltaFeed feed;
+    push_blocks(feed, 1, ChainDeltaFeed::maxEvents + 11);
+    assert(feed.begin_seq() == 10);
+    assert(feed.end_seq() == ChainDeltaFeed::maxEvents + 10);
+    assert(!feed.resume(Height(5), block_hash(5)));
+    assert(feed.resume(Height(10), block_hash(10)) == 10u); // base tip
+    assert(feed.resume(Height(11), block_hash(11)) == 11u);
+}
+
+// after a restart a client at our tip resumes without a resync
+void test_seeded_tip()
+{
+    ChainDeltaFeed feed;
+    feed.set_tip(Height(100), block_hash(100));
+    assert(feed.resume(Height(100), block_hash(100)) == feed.end_seq());
+    assert(!feed.resume(Height(100), block_hash(100, 1)));
+    assert(!feed.resume(Height(99), block_hash(99)));
+
+    push_blocks(feed, 101, 103);
+    assert(feed.resume(Height(100), block_hash(100)) == 0u);
+    assert(feed.resume(Height(102), block_hash(102)) == 2u);
+
+    // the seed is ignored once events were published
+    feed.set_tip(Height(5), block_hash(5));
+    assert(!feed.resume(Height(5), block_hash(5)));
+
+    // a rollback below the seeded tip loses the hash
+    ChainDeltaFeed f2;
+    f2.set_tip(Height(100), block_hash(100));
+    f2.push_rollback(Height(99), "rollback 99");
+    assert(!f2.resume(Height(99), block_hash(99)));
+    assert(f2.resume(Height(100), block_hash(100)) == 0u);
+}
+
+int main()
+{
+    test_resume();
+    test_eviction();
+    test_seeded_tip();
+    cout << "ChainDeltaFeed tests passed" << endl;
+    return 0;
+}
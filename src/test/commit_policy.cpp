@@ -0,0 +1,80 @@
+#include "eventloop/sync/block_download/commit_policy.hpp"
+#include <cassert>
+#include <iostream>
+using namespace std;
+using namespace std::chrono;
+using BlockDownload::CommitPolicy;
+
+void test_hold_back()
+{
+    CommitPolicy p;
+    auto now { steady_clock::now() };
+    const size_t small { CommitPolicy::minBytes - 1 };
+
+    // large additions, and everything once the window cannot grow, go now
+    assert(p.ready(CommitPolicy::minBytes, true, now));
+    assert(p.ready(small, false, now));
+    assert(!p.deadline());
+
+    // small additions are held back until the deadline
+    assert(!p.ready(small, true, now));
+    assert(p.deadline() == now + CommitPolicy::maxDelay);
+    assert(!p.ready(small, true, now + CommitPolicy::maxDelay - 1ms));
+    assert(p.deadline() == now + CommitPolicy::maxDelay); // not extended
+    assert(p.ready(small, true, now + CommitPolicy::maxDelay));
+
+    // staging and reset clear the deadline
+    p.on_stage(small);
+    assert(!p.deadline());
+    assert(!p.ready(small, true, now));
+    p.reset();
+    assert(!p.deadline());
+    assert(!p.ready(small, true, now + 1s));
+    assert(p.deadline() == now + 1s + CommitPolicy::maxDelay);
+}
+
+void test_sizing()
+{
+    CommitPolicy p;
+    const size_t initial { p.max_bytes() };
+    constexpr size_t MB { 1024 * 1024 };
+
+    // small or instant commits do not change the size
+    p.on_stage(CommitPolicy::minBytes - 1);
+    p.on_result(1ms);
+    assert(p.max_bytes() == initial);
+    p.on_stage(8 * MB);
+    p.on_result(0us);
+    assert(p.max_bytes() == initial);
+
+    // 8 MB/s and 500 ms target duration
+    p.on_stage(8 * MB);
+    p.on_result(1s);
+    assert(p.max_bytes() == 4 * MB);
+
+    // EWMA with weight 0.3 for the new rate of 16 MB/s
+    p.on_stage(8 * MB);
+    p.on_result(500ms);
+    const double rate { 0.7 * 8 * MB + 0.3 * 16 * MB };
+    assert(p.max_bytes() == size_t(rate * 0.5));
+
+    // clamped to the limits
+    for (int i = 0; i < 50; ++i) {
+        p.on_stage(32 * MB);
+        p.on_result(1ms);
+    }
+    assert(p.max_bytes() == CommitPolicy::maxBytesLimit);
+    for (int i = 0; i < 50; ++i) {
+        p.on_stage(CommitPolicy::minBytes);
+        p.on_result(100s);
+    }
+    assert(p.max_bytes() == CommitPolicy::minBytes);
+}
+
+int main()
+{
+    test_hold_back();
+    test_sizing();
+    cout << "CommitPolicy tests passed" << endl;
+    return 0;
+}
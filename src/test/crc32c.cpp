@@ -0,0 +1,40 @@
+#include "crypto/crc32c.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+void test_known_answers()
+{
+    const char* s = "123456789";
+    auto p = reinterpret_cast<const uint8_t*>(s);
+    assert(crc32c(p, strlen(s)) == 0xe3069283);
+    assert(crc32c_portable(p, strlen(s)) == 0xe3069283);
+    assert(crc32c(p, 0) == 0);
+    vector<uint8_t> zeros(32, 0);
+    assert(crc32c(zeros) == 0x8a9136aa);
+}
+
+void test_portable_equivalence()
+{
+    vector<uint8_t> v(100003);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = uint8_t(i * 7 + 3);
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t len : { 0ul, 1ul, 7ul, 8ul, 9ul, 63ul, 1000ul, 99000ul }) {
+            assert(crc32c(v.data() + offset, len) == crc32c_portable(v.data() + offset, len));
+        }
+    }
+    // incremental computation
+    assert(crc32c(v.data() + 5, 100, crc32c(v.data(), 5)) == crc32c(v.data(), 105));
+    assert(crc32c_portable(v.data() + 5, 100, crc32c_portable(v.data(), 5)) == crc32c(v.data(), 105));
+}
+
+int main()
+{
+    cout << "CRC32C hardware acceleration: " << (crc32c_hardware_accelerated() ? "yes" : "no") << endl;
+    test_known_answers();
+    test_portable_equivalence();
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "general/hex.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+void test_known_answers()
+{
+    const vector<uint8_t> v { 0x00, 0x01, 0x7f, 0x80, 0xab, 0xff };
+    assert(serialize_hex(v) == "00017f80abff");
+    assert(serialize_hex(uint32_t(0x1234abcd)) == "1234abcd");
+    assert(hex_to_vec("00017F80aBfF") == v);
+    vector<uint8_t> out;
+    assert(!parse_hex("0g", out));
+    assert(!parse_hex("000", out.data(), 1));
+}
+
+void test_portable_equivalence()
+{
+    vector<uint8_t> v(10007);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = uint8_t(i * 7 + 3);
+    for (size_t offset = 0; offset < 32; ++offset) {
+        for (size_t len : { 0ul, 1ul, 15ul, 16ul, 17ul, 31ul, 32ul, 33ul, 63ul, 64ul, 65ul, 1000ul, 9000ul }) {
+            string a(2 * len, ' '), b(2 * len, ' ');
+            serialize_hex(v.data() + offset, len, a.data());
+            serialize_hex_portable(v.data() + offset, len, b.data());
+            assert(a == b);
+            vector<uint8_t> d(len), p(len);
+            assert(parse_hex(a, d.data(), len));
+            assert(parse_hex_portable(a, p.data(), len));
+            assert(d == p);
+            assert(equal(d.begin(), d.end(), v.begin() + offset));
+        }
+    }
+}
+
+void test_invalid_characters()
+{
+    vector<uint8_t> v(100);
+    string s { serialize_hex(v) };
+    for (size_t i = 0; i < s.size(); ++i) {
+        for (char c : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', char(0xb0), char(0xe1) }) {
+            string t { s };
+            t[i] = c;
+            assert(!parse_hex(t, v.data(), v.size()));
+            assert(!parse_hex_portable(t, v.data(), v.size()));
+        }
+    }
+    // every valid character in every position
+    for (int c = 0; c < 256; ++c) {
+        bool valid { isxdigit(c) != 0 };
+        for (size_t i = 0; i < s.size(); ++i) {
+            string t { s };
+            t[i] = char(c);
+            assert(parse_hex(t, v.data(), v.size()) == valid);
+        }
+    }
+}
+
+int main()
+{
+    cout << "Hex acceleration: " << hex_acceleration() << endl;
+    test_known_answers();
+    test_portable_equivalence();
+    test_invalid_characters();
+    return 0;
+}
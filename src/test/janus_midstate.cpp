@@ -0,0 +1,143 @@
+#include "block/header/header_impl.hpp"
+#include "block/header/janus_midstate.hpp"
+#include "block/header/view_inline.hpp"
+#include "general/params.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+namespace {
+Header header_template(uint32_t target)
+{
+    Header t;
+    for (size_t i = 0; i < t.size(); ++i)
+        t[i] = uint8_t(i * 13 + 1);
+    t[32] = uint8_t(target >> 24);
+    t[33] = uint8_t(target >> 16);
+    t[34] = uint8_t(target >> 8);
+    t[35] = uint8_t(target);
+    return t;
+}
+
+struct VersionCase {
+    POWVersion version;
+    bool reachable; // whether valid nonces can be found in the test
+};
+
+vector<VersionCase> all_versions()
+{
+    // Janus3 to Janus5 reject verus hashes not below e^-21
+    const tuple<uint32_t, uint32_t, bool> params[] {
+        { 100, 1, true },
+        { JANUSV1RETARGETSTART + 1, 2, true },
+        { JANUSV2RETARGETSTART + 1, 2, true },
+        { JANUSV3RETARGETSTART + 1, 2, false },
+        { JANUSV4RETARGETSTART + 1, 2, false },
+        { JANUSV5RETARGETSTART + 1, 2, false },
+        { JANUSV6RETARGETSTART + 1, 2, true },
+        { JANUSV7RETARGETSTART + 1, 2, true },
+        { JANUSV8BLOCKV3START + 1, 3, true },
+    };
+    vector<VersionCase> v;
+    for (auto [height, version, reachable] : params) {
+        auto pv { POWVersion::from_params(NonzeroHeight(height), version, false) };
+        assert(pv);
+        v.push_back({ *pv, reachable });
+    }
+    return v;
+}
+
+// returns the number of valid nonces in [0, 300)
+size_t check_equivalence(const Header& t, POWVersion pv)
+{
+    JanusMidstate m(t, pv);
+    size_t valids { 0 };
+    optional<uint32_t> firstValid;
+    for (uint32_t n = 0; n < 300; ++n) {
+        Header h { m.header(n) };
+        assert(h.nonce() == n);
+        assert(m.hash(n) == h.hash());
+        bool valid { h.validPOW(h.hash(), pv) };
+        assert(m.valid(n) == valid);
+        if (valid) {
+            valids += 1;
+            if (!firstValid)
+                firstValid = n;
+        }
+    }
+    assert(m.scan(0, 300) == firstValid);
+    if (firstValid)
+        assert(m.scan(*firstValid + 1, *firstValid + 1) == nullopt);
+    return valids;
+}
+
+void test_validpow_equivalence()
+{
+    for (auto& [pv, reachable] : all_versions()) {
+        // target encodings differ between versions, make sure that some
+        // of the tried targets accept only part of the nonces
+        bool mixed { false };
+        for (uint32_t zeros = 0; zeros < 24; ++zeros) {
+            for (uint32_t target : { zeros << 24 | 0x800000, zeros << 22 | 0x200000 }) {
+                auto valids { check_equivalence(header_template(target), pv) };
+                mixed |= valids > 0 && valids < 300;
+            }
+        }
+        assert(mixed == reachable);
+    }
+}
+
+Hash verus_hash(const vector<uint8_t>& v, size_t begin, size_t end, bool v2_2)
+{
+    return Verus::VerusHasher().write(v.data() + begin, end - begin).finalize(v2_2);
+}
+
+// copies must not alias the internal buffers of their source
+void test_verus_hasher_copy()
+{
+    mt19937_64 rng(42);
+    vector<uint8_t> data(200);
+    for (auto& b : data)
+        b = uint8_t(rng());
+
+    for (bool v2_2 : { false, true }) {
+        const Hash expected { verus_hash(data, 0, 80, v2_2) };
+        // prefixes absorbing an even and odd number of 32 byte blocks,
+        // with and without a partial block
+        for (size_t prefix : { 0, 5, 32, 40, 64, 70 }) {
+            Verus::VerusHasher src;
+            src.write(data.data(), prefix);
+
+            Verus::VerusHasher copy { src };
+            Verus::VerusHasher assigned;
+            assigned.write(data.data() + 100, 50); // overwritten by the assignment
+            assigned = src;
+
+            // advancing and destroying the source state must not affect the copies
+            src.write(data.data() + 100, 100);
+            (void)src.finalize(v2_2);
+            src.reset();
+
+            assert(copy.write(data.data() + prefix, 80 - prefix).finalize(v2_2) == expected);
+            assert(assigned.write(data.data() + prefix, 80 - prefix).finalize(v2_2) == expected);
+        }
+
+        // self assignment keeps the state
+        Verus::VerusHasher h;
+        h.write(data.data(), 40);
+        auto& alias { h };
+        h = alias;
+        assert(h.write(data.data() + 40, 40).finalize(v2_2) == expected);
+    }
+}
+}
+
+int main()
+{
+    test_verus_hasher_copy();
+    test_validpow_equivalence();
+    cout << "JanusMidstate tests passed" << endl;
+    return 0;
+}
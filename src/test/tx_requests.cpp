@@ -0,0 +1,111 @@
+#include "eventloop/tx_requests.hpp"
+#include <cassert>
+#include <iostream>
+using namespace std;
+
+using std::chrono::steady_clock;
+
+TransactionId txid(uint64_t i)
+{
+    return { AccountId(i), PinHeight(Height(0)), NonceId(uint32_t(i)) };
+}
+
+vector<TransactionId> txids(uint64_t begin, uint64_t end)
+{
+    vector<TransactionId> v;
+    for (auto i { begin }; i < end; ++i)
+        v.push_back(txid(i));
+    return v;
+}
+
+void test_announce_once()
+{
+    TxRequests r;
+    auto now { steady_clock::now() };
+    assert(r.announce(1, txids(0, 10), now) == txids(0, 10));
+    // already in flight from connection 1
+    assert(r.announce(2, txids(5, 15), now) == txids(10, 15));
+    assert(r.announce(1, txids(0, 10), now).empty());
+    assert(r.size() == 15);
+    assert(r.next_expiry() == now + TxRequests::timeout);
+
+    assert(r.received(txid(3)));
+    assert(!r.received(txid(3)));
+    assert(!r.received(txid(100)));
+    assert(r.size() == 14);
+}
+
+void test_timeout_reassignment()
+{
+    TxRequests r;
+    auto now { steady_clock::now() };
+    (void)r.announce(1, txids(0, 4), now);
+    (void)r.announce(2, txids(0, 2), now);
+    (void)r.announce(3, txids(1, 2), now);
+    assert(r.pop_expired(now).empty());
+
+    // txid 0, 1 fall back to connection 2, txids 2, 3 have no announcer left
+    auto later { now + TxRequests::timeout };
+    auto a { r.pop_expired(later) };
+    assert(a.size() == 1);
+    assert(a[2] == txids(0, 2));
+    assert(r.size() == 2);
+
+    // txid 1 falls back to connection 3, txid 0 is dropped
+    a = r.pop_expired(later + TxRequests::timeout);
+    assert(a.size() == 1);
+    assert(a[3] == txids(1, 2));
+    assert(r.size() == 1);
+    a = r.pop_expired(later + 2 * TxRequests::timeout);
+    assert(a.empty());
+    assert(r.size() == 0);
+    assert(!r.next_expiry());
+}
+
+void test_erase_connection()
+{
+    TxRequests r;
+    auto now { steady_clock::now() };
+    (void)r.announce(1, txids(0, 3), now);
+    (void)r.announce(2, txids(0, 3), now);
+    (void)r.announce(3, txids(0, 1), now);
+
+    // connection 2 is no longer a fallback candidate
+    r.erase_connection(2);
+    assert(r.pop_expired(now).empty());
+
+    // requests of connection 1 are reassigned immediately
+    r.erase_connection(1);
+    auto a { r.pop_expired(steady_clock::now()) };
+    assert(a.size() == 1);
+    assert(a[3] == txids(0, 1));
+    assert(r.size() == 1);
+}
+
+void test_limits()
+{
+    TxRequests r;
+    auto now { steady_clock::now() };
+    auto many { txids(0, TxRequests::maxEntries + 10) };
+    assert(r.announce(1, many, now).size() == TxRequests::maxEntries);
+    assert(r.size() == TxRequests::maxEntries);
+
+    TxRequests s;
+    (void)s.announce(0, txids(0, 1), now);
+    for (uint64_t c = 1; c <= TxRequests::maxAnnouncers + 5; ++c)
+        (void)s.announce(c, txids(0, 1), now);
+    size_t fallbacks { 0 };
+    for (auto t { now + TxRequests::timeout }; s.size() > 0; t += TxRequests::timeout)
+        fallbacks += s.pop_expired(t).size();
+    assert(fallbacks == TxRequests::maxAnnouncers);
+}
+
+int main()
+{
+    test_announce_once();
+    test_timeout_reassignment();
+    test_erase_connection();
+    test_limits();
+    cout << "TxRequests tests passed" << endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "crypto/verushash/verus_clhash_opt.hpp"
+#include "crypto/verushash/verus_clhash_port.hpp"
+#include "crypto/verushash/verushash.hpp"
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+using namespace std;
+
+namespace {
+mt19937_64 rng(42);
+
+void fill_random(uint8_t* p, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        p[i] = uint8_t(rng());
+}
+
+Hash to_hash(const char* hex)
+{
+    Hash h;
+    for (size_t i = 0; i < 32; ++i)
+        h[i] = uint8_t(stoul(string(hex + 2 * i, 2), nullptr, 16));
+    return h;
+}
+
+// verusclhash key laid out like Verus::HashKey: key, refresh copy, move scratch
+struct Key {
+    static constexpr size_t size { 2 * Verus::keySizeInBytes };
+    alignas(32) uint8_t data[size];
+    __m128i** scratch() { return (__m128i**)(data + Verus::keySizeInBytes + Verus::keyRefreshsize); }
+};
+
+void test_known_answers()
+{
+    // computed with the portable implementation before hardware dispatch
+    vector<uint8_t> v(76);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = uint8_t(i);
+    assert(verus_hash_v2_1(v) == to_hash("6d4a2f1b2a9796b4c1724206dc5ca69c8401b695872a4384c90010b3d2a3ef1e"));
+    assert(verus_hash_v2_2(v) == to_hash("d8532a5561d28fb29e47bd9c2a103407676aec939825834d68d2c5d49d21ece1"));
+}
+
+void test_portable_equivalence()
+{
+    if (!verus_opt_supported())
+        return;
+    alignas(32) uint8_t in[64];
+    alignas(32) uint8_t out1[32], out2[32];
+    for (int n = 0; n < 1000; ++n) {
+        fill_random(in, sizeof(in));
+        haraka512_port(out1, in);
+        haraka512_opt(out2, in);
+        assert(memcmp(out1, out2, 32) == 0);
+        haraka256_port(out1, in);
+        haraka256_opt(out2, in);
+        assert(memcmp(out1, out2, 32) == 0);
+    }
+
+    auto k1 { make_unique<Key>() };
+    auto k2 { make_unique<Key>() };
+    for (int n = 0; n < 1000; ++n) {
+        fill_random(k1->data, Verus::keySizeInBytes);
+        memset(k1->data + Verus::keySizeInBytes, 0, Verus::keySizeInBytes);
+        fill_random(in, sizeof(in));
+        memcpy(k2->data, k1->data, Key::size);
+        haraka512_port_keyed(out1, in, (const u128*)k1->data + n % 32);
+        haraka512_opt_keyed(out2, in, (const u128*)k2->data + n % 32);
+        assert(memcmp(out1, out2, 32) == 0);
+
+        // also compares the key mutations
+        auto f1 { n % 2 ? verusclhash_sv2_1_port : verusclhash_sv2_2_port };
+        auto f2 { n % 2 ? verusclhash_sv2_1_opt : verusclhash_sv2_2_opt };
+        assert(f1(k1->data, in, Verus::keyMask, k1->scratch()) == f2(k2->data, in, Verus::keyMask, k2->scratch()));
+        assert(memcmp(k1->data, k2->data, Verus::keySizeInBytes) == 0);
+    }
+}
+}
+
+int main()
+{
+    cout << "VerusHash hardware acceleration: " << (verus_opt_supported() ? "yes" : "no") << endl;
+    test_known_answers();
+    test_portable_equivalence();
+    return 0;
+}
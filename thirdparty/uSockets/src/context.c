@@ -173,15 +173,7 @@ void us_socket_context_free(int ssl, struct us_socket_context_t *context) {
     free(context);
 }
 
-struct us_listen_socket_t *us_socket_context_listen(int ssl, struct us_socket_context_t *context, const char *host, int port, int options, int socket_ext_size) {
-#ifndef LIBUS_NO_SSL
-    if (ssl) {
-        return us_internal_ssl_socket_context_listen((struct us_internal_ssl_socket_context_t *) context, host, port, options, socket_ext_size);
-    }
-#endif
-
-    LIBUS_SOCKET_DESCRIPTOR listen_socket_fd = bsd_create_listen_socket(host, port, options);
-
+static struct us_listen_socket_t *us_internal_socket_context_listen_fd(struct us_socket_context_t *context, LIBUS_SOCKET_DESCRIPTOR listen_socket_fd, int socket_ext_size) {
     if (listen_socket_fd == LIBUS_SOCKET_ERROR) {
         return 0;
     }
@@ -203,6 +195,25 @@ struct us_listen_socket_t *us_socket_context_listen(int ssl, struct us_socket_co
     return ls;
 }
 
+struct us_listen_socket_t *us_socket_context_listen(int ssl, struct us_socket_context_t *context, const char *host, int port, int options, int socket_ext_size) {
+#ifndef LIBUS_NO_SSL
+    if (ssl) {
+        return us_internal_ssl_socket_context_listen((struct us_internal_ssl_socket_context_t *) context, host, port, options, socket_ext_size);
+    }
+#endif
+
+    return us_internal_socket_context_listen_fd(context, bsd_create_listen_socket(host, port, options), socket_ext_size);
+}
+
+struct us_listen_socket_t *us_socket_context_listen_unix(int ssl, struct us_socket_context_t *context, const char *path, int options, int socket_ext_size) {
+    /* Not implemented for SSL contexts */
+    if (ssl) {
+        return 0;
+    }
+
+    return us_internal_socket_context_listen_fd(context, bsd_create_listen_socket_unix(path, options), socket_ext_size);
+}
+
 struct us_socket_t *us_socket_context_connect(int ssl, struct us_socket_context_t *context, const char *host, int port, const char *source_host, int options, int socket_ext_size) {
 #ifndef LIBUS_NO_SSL
     if (ssl) {
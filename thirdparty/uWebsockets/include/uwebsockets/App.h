@@ -473,6 +473,12 @@ public:
         return std::move(*this);
     }
 
+    /* Callback, path to unix domain socket */
+    TemplatedApp &&listen_unix(MoveOnlyFunction<void(us_listen_socket_t *)> &&handler, std::string path, int options = 0) {
+        handler(httpContext ? httpContext->listen_unix(path.c_str(), options) : nullptr);
+        return std::move(*this);
+    }
+
 };
 
 typedef TemplatedApp<false> App;